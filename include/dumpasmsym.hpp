@@ -0,0 +1,206 @@
+/*
+	Copyright (c) 2025 Devon Artmeier
+
+	Permission to use, copy, modify, and /or distribute this software
+	for any purpose with or without fee is hereby granted.
+
+	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
+	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
+	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+	PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef DUMPASMSYM_HPP
+#define DUMPASMSYM_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class Symbols;
+struct SymbolReaderSlot;
+
+enum class DumpStatus
+{
+	Ok,
+	InvalidFormat,
+	BufferTooSmall,
+	Error
+};
+
+enum class DumpFilter
+{
+	SymbolInclude,
+	SymbolExclude,
+	PrefixInclude,
+	PrefixExclude,
+	SuffixInclude,
+	SuffixExclude,
+	PrefixAdd,
+	SuffixAdd,
+	ValueOffset,
+	ArchiveMember
+};
+
+enum class DumpOutputMode
+{
+	Binary,
+	Asm,
+	C,
+	AsmHash,
+	CHash
+};
+
+enum class DumpValueType
+{
+	Unsigned32,
+	Unsigned64,
+	Signed32,
+	Signed64
+};
+
+enum class DumpNumberBase
+{
+	Hex,
+	Decimal,
+	Binary
+};
+
+enum class DumpAsmDialect
+{
+	Asm68k,
+	Vasm,
+	Ca65,
+	Nasm,
+	Gas
+};
+
+struct DumpSymbol
+{
+	std::string name;
+	long long   value;
+};
+
+struct DumpOutputOptions
+{
+	DumpOutputMode mode        { DumpOutputMode::Binary };
+	DumpValueType  value_type  { DumpValueType::Unsigned32 };
+	DumpNumberBase number_base { DumpNumberBase::Hex };
+	DumpAsmDialect asm_dialect { DumpAsmDialect::Asm68k };
+};
+
+// Filters are applied while symbols are loaded, so they must be added before
+// the first call to Load. On failure, GetError returns a description, and a
+// failed Load leaves the symbols from earlier calls unchanged.
+// Render reports BufferTooSmall with the required size when the caller's
+// buffer cannot hold the output.
+class SymbolDumper
+{
+public:
+	SymbolDumper();
+	~SymbolDumper();
+
+	SymbolDumper(const SymbolDumper&)            = delete;
+	SymbolDumper& operator=(const SymbolDumper&) = delete;
+
+	DumpStatus         Load      (const std::string& input_name, const void* data, const size_t size);
+	DumpStatus         AddFilter (const DumpFilter filter, const std::string& value);
+	DumpStatus         GetSymbols(std::vector<DumpSymbol>& symbols_out);
+	DumpStatus         Render    (const DumpOutputOptions& options, void* buffer, const size_t capacity, size_t& size);
+	const std::string& GetError  () const;
+
+private:
+	DumpStatus Fail          (const DumpStatus status, const std::string& message);
+	void       UpdateSymbols ();
+
+	Symbols*    symbols { nullptr };
+	std::string error   { "" };
+	bool        dirty   { true };
+};
+
+// Immutable table of symbols ordered by value. FindValue returns the first
+// symbol at the highest value not above the one given, FindName an exact match.
+class SymbolSnapshot
+{
+public:
+	const DumpSymbol*              FindValue (const long long value) const;
+	const DumpSymbol*              FindName  (const std::string& name) const;
+	const std::vector<DumpSymbol>& GetSymbols() const;
+
+private:
+	friend class SymbolReloader;
+
+	std::vector<DumpSymbol> symbols;
+	std::vector<size_t>     name_order;
+};
+
+// Reload builds a new snapshot from the input files on a background thread and
+// publishes it with an atomic pointer swap; readers are never blocked. The
+// previous snapshot is freed by the reload thread once every SymbolReader has
+// released it. Filters are applied to reloads started after they are added.
+// Wait returns the result of the last reload, GetError a copy of the last
+// error, which may be called from any thread while a reload runs. AddFilter,
+// Reload and Wait must be called from the thread that owns the reloader. All
+// readers must be destroyed before it.
+class SymbolReloader
+{
+public:
+	SymbolReloader() = default;
+	~SymbolReloader();
+
+	SymbolReloader(const SymbolReloader&)            = delete;
+	SymbolReloader& operator=(const SymbolReloader&) = delete;
+
+	DumpStatus         AddFilter  (const DumpFilter filter, const std::string& value);
+	DumpStatus         Reload     (const std::vector<std::string>& file_names);
+	bool               IsReloading() const;
+	DumpStatus         Wait       ();
+	std::string        GetError   () const;
+
+private:
+	friend class SymbolReader;
+
+	void BuildSnapshot   (const std::vector<std::string> file_names, const std::vector<std::pair<DumpFilter, std::string>> filters);
+	void PublishSnapshot (SymbolSnapshot* new_snapshot);
+
+	std::vector<std::pair<DumpFilter, std::string>> filters;
+	std::atomic<SymbolSnapshot*>                    snapshot  { nullptr };
+	std::atomic<unsigned long long>                 epoch     { 1 };
+	std::atomic<SymbolReaderSlot*>                  readers   { nullptr };
+	std::atomic<bool>                               reloading { false };
+	std::thread                                     reload_thread;
+	mutable std::mutex                              result_mutex;
+	DumpStatus                                      status    { DumpStatus::Ok };
+	std::string                                     error     { "" };
+};
+
+// Per-thread handle for reading snapshots. Acquire returns the current snapshot
+// (nullptr before the first successful reload), which stays valid until Release.
+// Acquire and Release never lock or wait; keep the section between them short,
+// since a finished reload waits for it before freeing the previous snapshot.
+class SymbolReader
+{
+public:
+	explicit SymbolReader(SymbolReloader& reloader);
+	~SymbolReader();
+
+	SymbolReader(const SymbolReader&)            = delete;
+	SymbolReader& operator=(const SymbolReader&) = delete;
+
+	const SymbolSnapshot* Acquire();
+	void                  Release();
+
+private:
+	SymbolReloader&   reloader;
+	SymbolReaderSlot* slot { nullptr };
+};
+
+#endif // DUMPASMSYM_HPP
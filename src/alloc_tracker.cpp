@@ -0,0 +1,220 @@
+/*
+	Copyright (c) 2025 Devon Artmeier
+
+	Permission to use, copy, modify, and /or distribute this software
+	for any purpose with or without fee is hereby granted.
+
+	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
+	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
+	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+	PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <cstdlib>
+#include <new>
+
+#include "shared.hpp"
+#include "alloc_tracker.hpp"
+
+static const size_t MAX_PHASES  = 16;
+static const size_t BLOCK_ALIGN = 16;
+
+struct AllocationPhase
+{
+	const char*         name;
+	std::atomic<size_t> allocations;
+	std::atomic<size_t> bytes;
+	std::atomic<size_t> peak;
+};
+
+static AllocationPhase     phases[MAX_PHASES]  = {};
+static std::atomic<size_t> phase_count(1);
+static std::atomic<size_t> current_phase(0);
+static std::atomic<size_t> live_bytes(0);
+
+static void* TrackedAllocate(size_t size, size_t alignment)
+{
+	// Every block is prefixed with its size and its distance from the start of the real allocation
+	alignment = std::max(alignment, BLOCK_ALIGN);
+
+	unsigned char* block = static_cast<unsigned char*>(malloc(size + alignment + BLOCK_ALIGN));
+	if (block == nullptr) {
+		return nullptr;
+	}
+
+	uintptr_t      address = (reinterpret_cast<uintptr_t>(block) + BLOCK_ALIGN + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+	unsigned char* data    = reinterpret_cast<unsigned char*>(address);
+
+	reinterpret_cast<size_t*>(data)[-1] = size;
+	reinterpret_cast<size_t*>(data)[-2] = static_cast<size_t>(data - block);
+
+	AllocationPhase& phase = phases[current_phase.load(std::memory_order_relaxed)];
+	size_t           live  = live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+	size_t           peak  = phase.peak.load(std::memory_order_relaxed);
+
+	phase.allocations.fetch_add(1, std::memory_order_relaxed);
+	phase.bytes.fetch_add(size, std::memory_order_relaxed);
+	while (live > peak && !phase.peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+	}
+
+	return data;
+}
+
+static void TrackedFree(void* pointer)
+{
+	if (pointer == nullptr) {
+		return;
+	}
+
+	unsigned char* data = static_cast<unsigned char*>(pointer);
+	live_bytes.fetch_sub(reinterpret_cast<size_t*>(data)[-1], std::memory_order_relaxed);
+	free(data - reinterpret_cast<size_t*>(data)[-2]);
+}
+
+static void* TrackedNew(size_t size, size_t alignment)
+{
+	void* data = TrackedAllocate(size, alignment);
+	if (data == nullptr) {
+		throw std::bad_alloc();
+	}
+	return data;
+}
+
+void BeginAllocationPhase(const char* name)
+{
+	size_t phase = phase_count.load(std::memory_order_relaxed);
+	if (phase >= MAX_PHASES) {
+		return;
+	}
+
+	phases[phase].name = name;
+	phases[phase].peak.store(live_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	phase_count.store(phase + 1, std::memory_order_relaxed);
+	current_phase.store(phase, std::memory_order_relaxed);
+}
+
+void ReportAllocations()
+{
+	size_t total_allocations = 0;
+	size_t total_bytes       = 0;
+	size_t total_peak        = 0;
+
+	phases[0].name = "startup";
+
+	fprintf(stderr, "%-12s %14s %16s %16s\n", "Phase", "Allocations", "Bytes", "Peak heap");
+	for (size_t i = 0; i < phase_count.load(std::memory_order_relaxed); i++) {
+		size_t allocations = phases[i].allocations.load(std::memory_order_relaxed);
+		size_t bytes       = phases[i].bytes.load(std::memory_order_relaxed);
+		size_t peak        = phases[i].peak.load(std::memory_order_relaxed);
+
+		fprintf(stderr, "%-12s %14zu %16zu %16zu\n", phases[i].name, allocations, bytes, peak);
+		total_allocations += allocations;
+		total_bytes       += bytes;
+		total_peak         = std::max(total_peak, peak);
+	}
+	fprintf(stderr, "%-12s %14zu %16zu %16zu\n", "total", total_allocations, total_bytes, total_peak);
+}
+
+void* operator new(size_t size)
+{
+	return TrackedNew(size, BLOCK_ALIGN);
+}
+
+void* operator new[](size_t size)
+{
+	return TrackedNew(size, BLOCK_ALIGN);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	return TrackedAllocate(size, BLOCK_ALIGN);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+	return TrackedAllocate(size, BLOCK_ALIGN);
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+	return TrackedNew(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+	return TrackedNew(size, static_cast<size_t>(alignment));
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return TrackedAllocate(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return TrackedAllocate(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* pointer) noexcept
+{
+	TrackedFree(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+	TrackedFree(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+	TrackedFree(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept
+{
+	TrackedFree(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept
+{
+	TrackedFree(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept
+{
+	TrackedFree(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept
+{
+	TrackedFree(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept
+{
+	TrackedFree(pointer);
+}
+
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept
+{
+	TrackedFree(pointer);
+}
+
+void operator delete[](void* pointer, size_t, std::align_val_t) noexcept
+{
+	TrackedFree(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	TrackedFree(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	TrackedFree(pointer);
+}
@@ -0,0 +1,34 @@
+/*
+	Copyright (c) 2025 Devon Artmeier
+
+	Permission to use, copy, modify, and /or distribute this software
+	for any purpose with or without fee is hereby granted.
+
+	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
+	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
+	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+	PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef ALLOC_TRACKER_HPP
+#define ALLOC_TRACKER_HPP
+
+// Allocation phases are only counted in the instrumented build (DUMPASMSYM_TRACK_ALLOCATIONS)
+
+#ifdef TRACK_ALLOCATIONS
+
+void BeginAllocationPhase(const char* name);
+void ReportAllocations   ();
+
+#else
+
+static inline void BeginAllocationPhase(const char*) {}
+static inline void ReportAllocations   () {}
+
+#endif
+
+#endif // ALLOC_TRACKER_HPP
@@ -0,0 +1,291 @@
+/*
+	Copyright (c) 2025 Devon Artmeier
+
+	Permission to use, copy, modify, and /or distribute this software
+	for any purpose with or without fee is hereby granted.
+
+	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
+	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
+	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+	PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef DECODERS_HPP
+#define DECODERS_HPP
+
+// Binary record layouts are described as schemas of field types. Fields with a
+// fixed size are bounds checked once per record and loaded from constant offsets,
+// fields wrapped in Ignore are stepped over and left out of the decoded tuple
+
+static inline void CheckInput(const InputBuffer& input, const size_t count)
+{
+	if (count > input.size - input.offset) {
+		throw std::runtime_error("Reached end of file prematurely.");
+	}
+}
+
+template<size_t bytes, bool is_signed = false, bool big_endian = false>
+struct Integer
+{
+	static_assert(bytes >= 1 && bytes <= 8, "Integer fields must be 1 to 8 bytes wide.");
+	static constexpr size_t fixed_size = bytes;
+
+	static inline std::tuple<long long> Load(const unsigned char* data)
+	{
+		unsigned long long value = 0;
+		for (size_t i = 0; i < bytes; i++) {
+			value |= static_cast<unsigned long long>(data[big_endian ? (bytes - 1 - i) : i]) << (i * 8);
+		}
+
+		if constexpr (is_signed && bytes < 8) {
+			if (value & (1ULL << ((bytes * 8) - 1))) {
+				value |= ~((1ULL << (bytes * 8)) - 1);
+			}
+		}
+		return std::tuple<long long>(static_cast<long long>(value));
+	}
+
+	static inline std::tuple<long long> Read(InputBuffer& input)
+	{
+		CheckInput(input, bytes);
+		input.offset += bytes;
+		return Load(input.data + input.offset - bytes);
+	}
+
+	static inline void Skip(InputBuffer& input)
+	{
+		SkipInput(input, bytes);
+	}
+};
+
+template<size_t bytes>
+struct Bytes
+{
+	static constexpr size_t fixed_size = bytes;
+
+	static inline std::tuple<> Load(const unsigned char*)
+	{
+		return std::tuple<>();
+	}
+
+	static inline std::tuple<> Read(InputBuffer& input)
+	{
+		SkipInput(input, bytes);
+		return std::tuple<>();
+	}
+
+	static inline void Skip(InputBuffer& input)
+	{
+		SkipInput(input, bytes);
+	}
+};
+
+// vasm VOBJ number: values up to 0x7F are stored directly, otherwise 0x80 plus a
+// little endian byte count follows
+template<bool is_signed = false>
+struct VobjNumber
+{
+	static constexpr size_t fixed_size = 0;
+
+	static inline std::tuple<long long> Read(InputBuffer& input)
+	{
+		unsigned char bytes;
+		ReadInput(input, &bytes, 1);
+		if (bytes <= 0x7F) {
+			return std::tuple<long long>(bytes);
+		}
+
+		bytes -= 0x80;
+		if (bytes > 8) {
+			throw std::runtime_error(("Too many bytes specified for number (" + std::to_string(bytes) + ")").c_str());
+		}
+		CheckInput(input, bytes);
+
+		const unsigned char* data  = input.data + input.offset;
+		unsigned long long   value = 0;
+		for (unsigned char i = 0; i < bytes; i++) {
+			value |= static_cast<unsigned long long>(data[i]) << (i * 8);
+		}
+		input.offset += bytes;
+
+		if (is_signed && bytes != 0 && bytes < 8 && (value & (1ULL << ((bytes * 8) - 1)))) {
+			value |= ~((1ULL << (bytes * 8)) - 1);
+		}
+		return std::tuple<long long>(static_cast<long long>(value));
+	}
+
+	static inline void Skip(InputBuffer& input)
+	{
+		unsigned char bytes;
+		ReadInput(input, &bytes, 1);
+		if (bytes > 0x80) {
+			SkipInput(input, bytes - 0x80);
+		}
+	}
+};
+
+// String with a single byte character count in front
+struct PascalString
+{
+	static constexpr size_t fixed_size = 0;
+
+	static inline std::tuple<std::string> Read(InputBuffer& input)
+	{
+		unsigned char char_count;
+		ReadInput(input, &char_count, 1);
+
+		std::tuple<std::string> string(std::string(char_count, '\0'));
+		ReadInput(input, &std::get<0>(string)[0], char_count);
+		return string;
+	}
+
+	static inline void Skip(InputBuffer& input)
+	{
+		unsigned char char_count;
+		ReadInput(input, &char_count, 1);
+		SkipInput(input, char_count);
+	}
+};
+
+// NUL terminated string
+struct CString
+{
+	static constexpr size_t fixed_size = 0;
+
+	static inline std::tuple<std::string> Read(InputBuffer& input)
+	{
+		const unsigned char* string_start = input.data + input.offset;
+		const unsigned char* string_end   = static_cast<const unsigned char*>(memchr(string_start, 0, input.size - input.offset));
+
+		if (string_end == nullptr) {
+			throw std::runtime_error("Reached end of file prematurely.");
+		}
+		input.offset = (string_end - input.data) + 1;
+
+		return std::tuple<std::string>(std::string(reinterpret_cast<const char*>(string_start), string_end - string_start));
+	}
+
+	static inline void Skip(InputBuffer& input)
+	{
+		const unsigned char* string_start = input.data + input.offset;
+		const unsigned char* string_end   = static_cast<const unsigned char*>(memchr(string_start, 0, input.size - input.offset));
+
+		if (string_end == nullptr) {
+			throw std::runtime_error("Reached end of file prematurely.");
+		}
+		input.offset = (string_end - input.data) + 1;
+	}
+};
+
+// Element count followed by that many elements of a fixed size, skipped as a whole
+template<typename Count, size_t element_size>
+struct CountedBytes
+{
+	static constexpr size_t fixed_size = 0;
+
+	static inline std::tuple<> Read(InputBuffer& input)
+	{
+		Skip(input);
+		return std::tuple<>();
+	}
+
+	static inline void Skip(InputBuffer& input)
+	{
+		size_t count = static_cast<size_t>(std::get<0>(Count::Read(input)));
+		if (count > (input.size - input.offset) / element_size) {
+			throw std::runtime_error("Reached end of file prematurely.");
+		}
+		input.offset += count * element_size;
+	}
+};
+
+template<typename Field>
+struct Ignore
+{
+	static constexpr size_t fixed_size = Field::fixed_size;
+
+	static inline std::tuple<> Load(const unsigned char*)
+	{
+		return std::tuple<>();
+	}
+
+	static inline std::tuple<> Read(InputBuffer& input)
+	{
+		Field::Skip(input);
+		return std::tuple<>();
+	}
+
+	static inline void Skip(InputBuffer& input)
+	{
+		Field::Skip(input);
+	}
+};
+
+template<typename... Fields>
+struct Record
+{
+	static constexpr bool   is_fixed   = ((Fields::fixed_size != 0) && ...);
+	static constexpr size_t fixed_size = is_fixed ? (Fields::fixed_size + ... + 0) : 0;
+
+	static inline auto Read(InputBuffer& input)
+	{
+		if constexpr (is_fixed) {
+			CheckInput(input, fixed_size);
+			input.offset += fixed_size;
+			return Load<0, Fields...>(input.data + input.offset - fixed_size);
+		} else {
+			Values values;
+			ReadFields<0, Fields...>(input, values);
+			return values;
+		}
+	}
+
+	static inline void Skip(InputBuffer& input)
+	{
+		if constexpr (is_fixed) {
+			SkipInput(input, fixed_size);
+		} else {
+			(Fields::Skip(input), ...);
+		}
+	}
+
+private:
+	using Values = decltype(std::tuple_cat(Fields::Read(std::declval<InputBuffer&>())...));
+
+	template<size_t index, typename Field, typename... Rest>
+	static inline void ReadFields(InputBuffer& input, Values& values)
+	{
+		auto field = Field::Read(input);
+		if constexpr (std::tuple_size<decltype(field)>::value != 0) {
+			std::get<index>(values) = std::move(std::get<0>(field));
+		}
+		if constexpr (sizeof...(Rest) != 0) {
+			ReadFields<index + std::tuple_size<decltype(field)>::value, Rest...>(input, values);
+		}
+	}
+
+	template<size_t offset, typename Field, typename... Rest>
+	static inline auto Load(const unsigned char* data)
+	{
+		if constexpr (sizeof...(Rest) == 0) {
+			return Field::Load(data + offset);
+		} else {
+			return std::tuple_cat(Field::Load(data + offset), Load<offset + Field::fixed_size, Rest...>(data));
+		}
+	}
+};
+
+// BSYM layouts, shared by the loader and the append writer
+using BsymHeader = Record<Bytes<4>, Integer<4>>;
+using BsymSymbol = Record<PascalString, Integer<8>>;
+using BsymName   = Record<PascalString>;
+
+// History store header and section offsets
+using HistoryHeader  = Record<Bytes<4>, Integer<4>, Integer<4>, Integer<4>, Integer<4>>;
+using HistorySection = Record<Integer<8>>;
+
+#endif // DECODERS_HPP
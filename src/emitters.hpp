@@ -0,0 +1,298 @@
+/*
+	Copyright (c) 2025 Devon Artmeier
+
+	Permission to use, copy, modify, and /or distribute this software
+	for any purpose with or without fee is hereby granted.
+
+	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
+	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
+	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+	PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef EMITTERS_HPP
+#define EMITTERS_HPP
+
+static const size_t OUTPUT_BUFFER_SIZE   = 0x10000;
+static const size_t RENDER_CHUNK_SYMBOLS = 0x4000;
+
+struct Asm68kDialect
+{
+	static constexpr const char* comment_start = "; ";
+	static constexpr const char* comment_end   = "";
+	static constexpr const char* line_start    = "";
+	static constexpr const char* name_end      = "";
+	static constexpr const char* separator     = "equ ";
+	static constexpr const char* line_end      = "";
+	static constexpr const char* hex_prefix    = "$";
+	static constexpr const char* bin_prefix    = "%";
+	static constexpr const char* data_long     = "\tdc.l ";
+	static constexpr const char* data_string   = "\tdc.b \"";
+	static constexpr const char* string_end    = "\",0";
+};
+
+struct VasmDialect : Asm68kDialect
+{
+};
+
+struct Ca65Dialect : Asm68kDialect
+{
+	static constexpr const char* separator   = "= ";
+	static constexpr const char* data_long   = "\t.dword ";
+	static constexpr const char* data_string = "\t.byte \"";
+};
+
+struct NasmDialect : Asm68kDialect
+{
+	static constexpr const char* hex_prefix  = "0x";
+	static constexpr const char* bin_prefix  = "0b";
+	static constexpr const char* data_long   = "\tdd ";
+	static constexpr const char* data_string = "\tdb \"";
+};
+
+struct GasDialect
+{
+	static constexpr const char* comment_start = "/* ";
+	static constexpr const char* comment_end   = " */";
+	static constexpr const char* line_start    = ".equ ";
+	static constexpr const char* name_end      = ",";
+	static constexpr const char* separator     = "";
+	static constexpr const char* line_end      = "";
+	static constexpr const char* hex_prefix    = "0x";
+	static constexpr const char* bin_prefix    = "0b";
+	static constexpr const char* data_long     = "\t.long ";
+	static constexpr const char* data_string   = "\t.asciz \"";
+	static constexpr const char* string_end    = "\"";
+};
+
+struct CDialect
+{
+	static constexpr const char* comment_start = "// ";
+	static constexpr const char* comment_end   = "";
+	static constexpr const char* line_start    = "#define ";
+	static constexpr const char* name_end      = "";
+	static constexpr const char* separator     = " (";
+	static constexpr const char* line_end      = ")";
+	static constexpr const char* hex_prefix    = "0x";
+	static constexpr const char* bin_prefix    = "0b";
+};
+
+static inline void AppendHex(std::string& output, unsigned long long value)
+{
+	char  digits[16];
+	char* digit = digits + sizeof(digits);
+
+	do {
+		*--digit = "0123456789ABCDEF"[value & 0xF];
+		value >>= 4;
+	} while (value != 0);
+
+	output.append(digit, digits + sizeof(digits) - digit);
+}
+
+static inline void AppendDecimal(std::string& output, long long value)
+{
+	char               digits[20];
+	char*              digit     = digits + sizeof(digits);
+	unsigned long long magnitude = static_cast<unsigned long long>(value);
+
+	if (value < 0) {
+		output += '-';
+		magnitude = 0 - magnitude;
+	}
+
+	do {
+		*--digit = static_cast<char>('0' + (magnitude % 10));
+		magnitude /= 10;
+	} while (magnitude != 0);
+
+	output.append(digit, digits + sizeof(digits) - digit);
+}
+
+template<int bits>
+static inline void AppendBinary(std::string& output, const unsigned long long value)
+{
+	char digits[bits];
+	for (int i = 0; i < bits; i++) {
+		digits[i] = static_cast<char>('0' + ((value >> (bits - 1 - i)) & 1));
+	}
+	output.append(digits, bits);
+}
+
+template<typename Dialect, ValueType value_type, NumberBase number_base>
+static inline void AppendValue(std::string& output, long long value)
+{
+	constexpr bool is_signed = value_type == ValueType::Signed32 || value_type == ValueType::Signed64;
+	constexpr bool is_32_bit = value_type == ValueType::Unsigned32 || value_type == ValueType::Signed32;
+
+	if constexpr (is_signed) {
+		if (value < 0) {
+			output += '-';
+			value = static_cast<long long>(0 - static_cast<unsigned long long>(value));
+		} else {
+			output += ' ';
+		}
+	}
+
+	if constexpr (is_32_bit) {
+		value &= 0xFFFFFFFF;
+	}
+
+	if constexpr (number_base == NumberBase::Hex) {
+		output += Dialect::hex_prefix;
+		AppendHex(output, static_cast<unsigned long long>(value));
+	} else if constexpr (number_base == NumberBase::Decimal) {
+		AppendDecimal(output, value);
+	} else {
+		output += Dialect::bin_prefix;
+		AppendBinary<is_32_bit ? 32 : 64>(output, static_cast<unsigned long long>(value));
+	}
+}
+
+template<typename Dialect, ValueType value_type, NumberBase number_base>
+static inline void AppendSymbolLine(std::string& output, const Symbol& symbol, const size_t line_length, const std::string& value_offset)
+{
+	output += Dialect::line_start;
+
+	size_t name_start = output.size();
+	output += symbol.name;
+	output += Dialect::name_end;
+
+	size_t name_length = output.size() - name_start;
+	if (name_length < line_length) {
+		output.append(line_length - name_length, ' ');
+	}
+
+	output += Dialect::separator;
+	AppendValue<Dialect, value_type, number_base>(output, symbol.value);
+	if (!value_offset.empty()) {
+		output += '+';
+		output += value_offset;
+	}
+	output += Dialect::line_end;
+	output += '\n';
+}
+
+template<typename Dialect>
+static inline void AppendComment(std::string& output, const std::string& comment)
+{
+	output += Dialect::comment_start;
+	output += comment;
+	output += Dialect::comment_end;
+}
+
+template<typename Dialect>
+void Symbols::OutputText(std::ostream& output, const ValueType value_type, const NumberBase number_base)
+{
+	const std::string        separator = "------------------------------------------------------------------------------";
+	std::vector<std::string> buffers(1);
+
+	if (input_file_names.empty()) {
+		AppendComment<Dialect>(buffers.back(), separator);
+		buffers.back() += '\n';
+		AppendComment<Dialect>(buffers.back(), "No valid symbol files found");
+		buffers.back() += '\n';
+		AppendComment<Dialect>(buffers.back(), separator);
+	} else {
+		AppendComment<Dialect>(buffers.back(), separator);
+		buffers.back() += '\n';
+		AppendComment<Dialect>(buffers.back(), "Symbols extracted from");
+		buffers.back() += '\n';
+		for (const auto& input_file_name : input_file_names) {
+			AppendComment<Dialect>(buffers.back(), input_file_name);
+			buffers.back() += '\n';
+		}
+		AppendComment<Dialect>(buffers.back(), separator);
+		buffers.back() += "\n\n";
+
+		switch (value_type) {
+			case ValueType::Unsigned32:
+				this->OutputTextSymbols<Dialect, ValueType::Unsigned32>(output, buffers, number_base);
+				break;
+			case ValueType::Unsigned64:
+				this->OutputTextSymbols<Dialect, ValueType::Unsigned64>(output, buffers, number_base);
+				break;
+			case ValueType::Signed32:
+				this->OutputTextSymbols<Dialect, ValueType::Signed32>(output, buffers, number_base);
+				break;
+			case ValueType::Signed64:
+				this->OutputTextSymbols<Dialect, ValueType::Signed64>(output, buffers, number_base);
+				break;
+		}
+
+		buffers.back() += '\n';
+		AppendComment<Dialect>(buffers.back(), separator);
+	}
+
+	WriteBuffers(output, buffers);
+}
+
+template<typename Dialect, ValueType value_type>
+void Symbols::OutputTextSymbols(std::ostream& output, std::vector<std::string>& buffers, const NumberBase number_base)
+{
+	switch (number_base) {
+		case NumberBase::Hex:
+			this->OutputTextLines<Dialect, value_type, NumberBase::Hex>(output, buffers);
+			break;
+		case NumberBase::Decimal:
+			this->OutputTextLines<Dialect, value_type, NumberBase::Decimal>(output, buffers);
+			break;
+		case NumberBase::Binary:
+			this->OutputTextLines<Dialect, value_type, NumberBase::Binary>(output, buffers);
+			break;
+	}
+}
+
+template<typename Dialect, ValueType value_type, NumberBase number_base>
+void Symbols::OutputTextLines(std::ostream& output, std::vector<std::string>& buffers)
+{
+	size_t line_length = static_cast<size_t>(this->GetLineLength());
+	size_t chunk_count = (this->symbols_out.size() + RENDER_CHUNK_SYMBOLS - 1) / RENDER_CHUNK_SYMBOLS;
+
+	if (!this->value_runs.runs.empty() || this->streaming || chunk_count < 2) {
+		this->ForEachOutputSymbol([&](const Symbol& symbol) {
+			AppendSymbolLine<Dialect, value_type, number_base>(buffers.back(), symbol, line_length, this->value_offset);
+			if (buffers.back().size() >= OUTPUT_BUFFER_SIZE) {
+				WriteBuffers(output, buffers);
+				buffers.assign(1, std::string());
+			}
+		});
+		return;
+	}
+
+	// Render fixed-size chunks of the sorted table in parallel, then hand them over in order
+	size_t              first_chunk  = buffers.size();
+	std::atomic<size_t> next_chunk(0);
+	size_t              thread_count = std::min<size_t>(std::max(1U, std::thread::hardware_concurrency()), chunk_count);
+
+	buffers.resize(first_chunk + chunk_count + 1);
+
+	auto render_chunks = [&]() {
+		size_t chunk;
+		while ((chunk = next_chunk++) < chunk_count) {
+			size_t       start  = chunk * RENDER_CHUNK_SYMBOLS;
+			size_t       end    = std::min(start + RENDER_CHUNK_SYMBOLS, this->symbols_out.size());
+			std::string& buffer = buffers[first_chunk + chunk];
+
+			buffer.reserve((end - start) * (line_length + 32));
+			for (size_t i = start; i < end; i++) {
+				AppendSymbolLine<Dialect, value_type, number_base>(buffer, this->symbols_out[i], line_length, this->value_offset);
+			}
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (size_t i = 1; i < thread_count; i++) {
+		threads.emplace_back(render_chunks);
+	}
+	render_chunks();
+	for (auto& thread : threads) {
+		thread.join();
+	}
+}
+
+#endif // EMITTERS_HPP
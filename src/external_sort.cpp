@@ -0,0 +1,380 @@
+/*
+	Copyright (c) 2025 Devon Artmeier
+
+	Permission to use, copy, modify, and /or distribute this software
+	for any purpose with or without fee is hereby granted.
+
+	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
+	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
+	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+	PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "shared.hpp"
+
+static const size_t MIN_RUN_BUFFER_SIZE = 0x1000;
+static const size_t MAX_RUN_BUFFER_SIZE = 0x10000;
+static const size_t HEAP_BLOCK_OVERHEAD = 16;
+static const size_t RUN_HEADER_SIZE     = 12;
+
+// The memory limit is split between the batch of symbols being gathered (a quarter), the buffers
+// of the runs being merged (an eighth) and the buffers of the temporary files. Batches reserve
+// their slots up front, so they never grow past their share.
+
+struct RunReader
+{
+	FILE*                      file;
+	unsigned long long         position;
+	unsigned long long         end;
+	std::vector<unsigned char> buffer;
+	size_t                     offset;
+	size_t                     size;
+};
+
+struct RunHead
+{
+	Symbol symbol;
+	size_t run;
+};
+
+static bool CompareSymbolNames(const Symbol& symbol_1, const Symbol& symbol_2)
+{
+	int compare = symbol_1.name.compare(symbol_2.name);
+	return compare < 0 || (compare == 0 && symbol_1.value < symbol_2.value);
+}
+
+static bool CompareSymbolValues(const Symbol& symbol_1, const Symbol& symbol_2)
+{
+	return symbol_1.value < symbol_2.value || (symbol_1.value == symbol_2.value && symbol_1.name < symbol_2.name);
+}
+
+static size_t GetRunBufferSize(const size_t max_memory)
+{
+	return std::min(std::max(max_memory / 32, MIN_RUN_BUFFER_SIZE), MAX_RUN_BUFFER_SIZE);
+}
+
+static size_t GetFanIn(const size_t max_memory)
+{
+	return std::max<size_t>(2, (max_memory / 8) / GetRunBufferSize(max_memory));
+}
+
+static size_t GetBatchSlots(const size_t max_memory)
+{
+	return (max_memory / 8) / sizeof(Symbol);
+}
+
+static size_t GetBatchNameMemory(const size_t max_memory)
+{
+	return max_memory / 8;
+}
+
+static size_t GetNameMemory(const Symbol& symbol)
+{
+	// Names too long for the string's inline storage take a heap block of their own
+	static const size_t inline_size = std::string().capacity();
+
+	if (symbol.name.capacity() <= inline_size) {
+		return 0;
+	}
+	return symbol.name.capacity() + 1 + HEAP_BLOCK_OVERHEAD;
+}
+
+static void SeekSpillFile(FILE* file, const unsigned long long position)
+{
+#ifdef _WIN32
+	int result = _fseeki64(file, static_cast<long long>(position), SEEK_SET);
+#else
+	int result = fseeko(file, static_cast<off_t>(position), SEEK_SET);
+#endif
+	if (result != 0) {
+		throw std::runtime_error("Failed to read from temporary file.");
+	}
+}
+
+static void BeginRun(SpillFile& spill, const size_t buffer_size)
+{
+	if (spill.file == nullptr) {
+		spill.file = std::tmpfile();
+		if (spill.file == nullptr) {
+			throw std::runtime_error("Cannot create temporary file.");
+		}
+		setvbuf(spill.file, nullptr, _IOFBF, buffer_size);
+	}
+
+	// Runs are read back from their own offsets, so every new run starts at the end of the file
+	SeekSpillFile(spill.file, spill.size);
+	spill.runs.push_back({ spill.size, 0 });
+}
+
+static void CloseSpillFile(SpillFile& spill)
+{
+	if (spill.file != nullptr) {
+		fclose(spill.file);
+	}
+	spill.file = nullptr;
+	spill.size = 0;
+	spill.runs.clear();
+}
+
+static void WriteRunSymbol(SpillFile& spill, const Symbol& symbol)
+{
+	unsigned char header[RUN_HEADER_SIZE];
+	size_t        name_size = symbol.name.size();
+
+	for (int i = 0; i < 4; i++) {
+		header[i] = (name_size >> (i * 8)) & 0xFF;
+	}
+	for (int i = 0; i < 8; i++) {
+		header[4 + i] = (static_cast<unsigned long long>(symbol.value) >> (i * 8)) & 0xFF;
+	}
+
+	if (fwrite(header, 1, RUN_HEADER_SIZE, spill.file) != RUN_HEADER_SIZE || fwrite(symbol.name.data(), 1, name_size, spill.file) != name_size) {
+		throw std::runtime_error("Failed to write to temporary file.");
+	}
+	spill.size            += RUN_HEADER_SIZE + name_size;
+	spill.runs.back().size += RUN_HEADER_SIZE + name_size;
+}
+
+static bool FillRunReader(RunReader& reader)
+{
+	if (reader.position >= reader.end) {
+		return false;
+	}
+
+	size_t count = static_cast<size_t>(std::min<unsigned long long>(reader.buffer.size(), reader.end - reader.position));
+	SeekSpillFile(reader.file, reader.position);
+	if (fread(reader.buffer.data(), 1, count, reader.file) != count) {
+		throw std::runtime_error("Failed to read from temporary file.");
+	}
+
+	reader.position += count;
+	reader.offset    = 0;
+	reader.size      = count;
+	return true;
+}
+
+static void ReadRunBytes(RunReader& reader, void* data, size_t count)
+{
+	unsigned char* read_data = static_cast<unsigned char*>(data);
+
+	while (count > 0) {
+		if (reader.offset == reader.size && !FillRunReader(reader)) {
+			throw std::runtime_error("Failed to read from temporary file.");
+		}
+
+		size_t read_count = std::min(count, reader.size - reader.offset);
+		memcpy(read_data, reader.buffer.data() + reader.offset, read_count);
+		reader.offset += read_count;
+		read_data     += read_count;
+		count         -= read_count;
+	}
+}
+
+static bool ReadRunSymbol(RunReader& reader, Symbol& symbol)
+{
+	if (reader.offset == reader.size && !FillRunReader(reader)) {
+		return false;
+	}
+
+	unsigned char header[RUN_HEADER_SIZE];
+	ReadRunBytes(reader, header, RUN_HEADER_SIZE);
+
+	size_t             name_size = 0;
+	unsigned long long value     = 0;
+	for (int i = 3; i >= 0; i--) {
+		name_size = (name_size << 8) | header[i];
+	}
+	for (int i = 7; i >= 0; i--) {
+		value = (value << 8) | header[4 + i];
+	}
+
+	symbol.name.resize(name_size);
+	if (name_size != 0) {
+		ReadRunBytes(reader, &symbol.name[0], name_size);
+	}
+	symbol.value = static_cast<long long>(value);
+
+	return true;
+}
+
+static void WriteRun(SpillFile& spill, std::vector<Symbol>& symbols, bool (*compare)(const Symbol&, const Symbol&), const size_t buffer_size)
+{
+	std::sort(symbols.begin(), symbols.end(), compare);
+
+	BeginRun(spill, buffer_size);
+	for (const auto& symbol : symbols) {
+		WriteRunSymbol(spill, symbol);
+	}
+
+	// The batch keeps its reserved slots for the next run
+	symbols.clear();
+}
+
+static void MergeRuns(const SpillFile& spill, const size_t first_run, const size_t run_count, bool (*compare)(const Symbol&, const Symbol&),
+                      const size_t buffer_size, const std::function<void(const Symbol&)>& callback)
+{
+	auto compare_heads = [compare](const RunHead& head_1, const RunHead& head_2) {
+		return compare(head_2.symbol, head_1.symbol);
+	};
+	std::priority_queue<RunHead, std::vector<RunHead>, decltype(compare_heads)> heads(compare_heads);
+	std::vector<RunReader>                                                      readers;
+
+	readers.reserve(run_count);
+	for (size_t i = 0; i < run_count; i++) {
+		const SpillRun& run = spill.runs[first_run + i];
+		readers.push_back({ spill.file, run.offset, run.offset + run.size, std::vector<unsigned char>(buffer_size), 0, 0 });
+
+		RunHead head;
+		if (ReadRunSymbol(readers.back(), head.symbol)) {
+			head.run = i;
+			heads.push(std::move(head));
+		}
+	}
+
+	while (!heads.empty()) {
+		RunHead head = heads.top();
+		heads.pop();
+
+		callback(head.symbol);
+		if (ReadRunSymbol(readers[head.run], head.symbol)) {
+			heads.push(std::move(head));
+		}
+	}
+}
+
+static void ReduceRuns(SpillFile& spill, bool (*compare)(const Symbol&, const Symbol&), const size_t fan_in, const size_t buffer_size)
+{
+	// Each pass merges groups of runs into a new file, so only one pass worth of data is written twice
+	while (spill.runs.size() > fan_in) {
+		SpillFile merged;
+
+		try {
+			for (size_t i = 0; i < spill.runs.size(); i += fan_in) {
+				BeginRun(merged, buffer_size);
+				MergeRuns(spill, i, std::min(fan_in, spill.runs.size() - i), compare, buffer_size, [&](const Symbol& symbol) {
+					WriteRunSymbol(merged, symbol);
+				});
+			}
+		} catch (...) {
+			CloseSpillFile(merged);
+			throw;
+		}
+
+		CloseSpillFile(spill);
+		spill = std::move(merged);
+	}
+}
+
+void Symbols::BufferSymbol(const std::string& name, long long value)
+{
+	if (this->symbol_buffer.capacity() == 0) {
+		this->symbol_buffer.reserve(GetBatchSlots(this->max_memory));
+	}
+
+	this->symbol_buffer.push_back({ name, value });
+	this->buffer_memory += GetNameMemory(this->symbol_buffer.back());
+
+	if (this->symbol_buffer.size() >= this->symbol_buffer.capacity() || this->buffer_memory >= GetBatchNameMemory(this->max_memory)) {
+		this->SpillSymbols();
+	}
+}
+
+void Symbols::SpillSymbols()
+{
+	WriteRun(this->name_runs, this->symbol_buffer, CompareSymbolNames, GetRunBufferSize(this->max_memory));
+	this->buffer_memory = 0;
+}
+
+void Symbols::MergeSpilledSymbols()
+{
+	size_t fan_in      = GetFanIn(this->max_memory);
+	size_t buffer_size = GetRunBufferSize(this->max_memory);
+	
+	if (this->name_runs.runs.empty()) {
+		std::sort(this->symbol_buffer.begin(), this->symbol_buffer.end(), CompareSymbolNames);
+	} else {
+		if (!this->symbol_buffer.empty()) {
+			this->SpillSymbols();
+		}
+		std::vector<Symbol>().swap(this->symbol_buffer);
+		ReduceRuns(this->name_runs, CompareSymbolNames, fan_in, buffer_size);
+	}
+
+	std::vector<Symbol> merged_symbols;
+	size_t              merged_memory = 0;
+	bool                have_previous = false;
+	Symbol              previous;
+
+	merged_symbols.reserve(GetBatchSlots(this->max_memory));
+	this->symbols_out.clear();
+	this->output_count   = 0;
+	this->output_length  = 0;
+	this->unmapped_count = 0;
+	this->CompileRemapRanges();
+
+	auto merge_symbol = [&](const Symbol& symbol) {
+		if (have_previous && symbol.name == previous.name) {
+			if (symbol.value != previous.value) {
+				throw std::runtime_error(("Multiple definitions of symbol \"" + symbol.name + "\" detected.").c_str());
+			}
+			return;
+		}
+		previous      = symbol;
+		have_previous = true;
+
+		Symbol output_symbol = { this->prefix_add + symbol.name + this->suffix_add, symbol.value };
+		if (!this->remap_ranges.empty() && !this->RemapSymbol(output_symbol)) {
+			return;
+		}
+
+		merged_symbols.push_back(std::move(output_symbol));
+		merged_memory += GetNameMemory(merged_symbols.back());
+		this->output_length = std::max(this->output_length, static_cast<int>(merged_symbols.back().name.size()));
+		this->output_count++;
+
+		if (merged_symbols.size() >= merged_symbols.capacity() || merged_memory >= GetBatchNameMemory(this->max_memory)) {
+			WriteRun(this->value_runs, merged_symbols, CompareSymbolValues, buffer_size);
+			merged_memory = 0;
+		}
+	};
+
+	if (this->name_runs.runs.empty()) {
+		for (const auto& symbol : this->symbol_buffer) {
+			merge_symbol(symbol);
+		}
+		std::vector<Symbol>().swap(this->symbol_buffer);
+	} else {
+		MergeRuns(this->name_runs, 0, this->name_runs.runs.size(), CompareSymbolNames, buffer_size, merge_symbol);
+		CloseSpillFile(this->name_runs);
+	}
+
+	if (this->value_runs.runs.empty()) {
+		std::sort(merged_symbols.begin(), merged_symbols.end(), CompareSymbolValues);
+		this->symbols_out = std::move(merged_symbols);
+	} else {
+		if (!merged_symbols.empty()) {
+			WriteRun(this->value_runs, merged_symbols, CompareSymbolValues, buffer_size);
+		}
+		std::vector<Symbol>().swap(merged_symbols);
+		ReduceRuns(this->value_runs, CompareSymbolValues, fan_in, buffer_size);
+	}
+
+	this->ReportUnmappedSymbols();
+}
+
+size_t Symbols::GetOutputCount()
+{
+	if (this->value_runs.runs.empty() && !this->streaming) {
+		return this->symbols_out.size();
+	}
+	return this->output_count;
+}
+
+void Symbols::MergeOutputRuns(const std::function<void(const Symbol&)>& callback)
+{
+	MergeRuns(this->value_runs, 0, this->value_runs.runs.size(), CompareSymbolValues, GetRunBufferSize(this->max_memory), callback);
+}
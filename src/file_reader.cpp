@@ -0,0 +1,393 @@
+/*
+	Copyright (c) 2025 Devon Artmeier
+
+	Permission to use, copy, modify, and /or distribute this software
+	for any purpose with or without fee is hereby granted.
+
+	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
+	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
+	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+	PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "shared.hpp"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#endif
+
+static const size_t MAP_FILE_SIZE = 0x100000;
+
+#ifndef _WIN32
+
+MappedFile::~MappedFile()
+{
+	if (this->data != nullptr) {
+		munmap(this->data, this->size);
+	}
+}
+
+bool MappedFile::Open(const std::string& file_name)
+{
+	int fd = open(file_name.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0) {
+		return false;
+	}
+
+	struct stat file_stat;
+	if (fstat(fd, &file_stat) != 0 || !S_ISREG(file_stat.st_mode) || static_cast<size_t>(file_stat.st_size) < MAP_FILE_SIZE) {
+		close(fd);
+		return false;
+	}
+
+	void* mapping = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (mapping == MAP_FAILED) {
+		return false;
+	}
+
+	this->data = mapping;
+	this->size = static_cast<size_t>(file_stat.st_size);
+	return true;
+}
+
+const unsigned char* MappedFile::GetData() const
+{
+	return static_cast<const unsigned char*>(this->data);
+}
+
+size_t MappedFile::GetSize() const
+{
+	return this->size;
+}
+
+#endif
+
+static void ReadFilesParallel(const std::vector<std::string>& file_names, const std::vector<size_t>& indexes,
+                              std::vector<std::vector<unsigned char>>& buffers)
+{
+	std::vector<std::exception_ptr> errors(indexes.size());
+	std::atomic<size_t>             next_index(0);
+	size_t                          thread_count = std::min<size_t>(std::max(1U, std::thread::hardware_concurrency()), indexes.size());
+
+	auto read_files = [&]() {
+		size_t index;
+		while ((index = next_index++) < indexes.size()) {
+			try {
+				ReadFile(file_names[indexes[index]], buffers[indexes[index]]);
+			} catch (...) {
+				errors[index] = std::current_exception();
+			}
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (size_t i = 1; i < thread_count; i++) {
+		threads.emplace_back(read_files);
+	}
+	read_files();
+	for (auto& thread : threads) {
+		thread.join();
+	}
+
+	for (const auto& error : errors) {
+		if (error) {
+			std::rethrow_exception(error);
+		}
+	}
+}
+
+#ifdef __linux__
+
+static const unsigned URING_ENTRIES   = 256;
+static const unsigned URING_PROBE_OPS = 256;
+
+// Reads through the ring carry their length in a 32-bit field and their result in an int,
+// larger files are mapped instead
+static_assert(MAP_FILE_SIZE <= INT_MAX, "Ring reads must fit in an io_uring result.");
+
+class FileRing
+{
+public:
+	~FileRing();
+
+	bool Setup  ();
+	void Submit (const std::function<void(io_uring_sqe&, const size_t)>& prepare, const size_t count,
+	             const std::function<void(const size_t, const int)>& complete);
+
+private:
+	int                 ring_fd      { -1 };
+	void*               sq_ring      { MAP_FAILED };
+	void*               cq_ring      { MAP_FAILED };
+	io_uring_sqe*       sqes         { static_cast<io_uring_sqe*>(MAP_FAILED) };
+	size_t              sq_ring_size { 0 };
+	size_t              cq_ring_size { 0 };
+	size_t              sqes_size    { 0 };
+	io_uring_params     params;
+};
+
+FileRing::~FileRing()
+{
+	if (this->sqes != MAP_FAILED) {
+		munmap(this->sqes, this->sqes_size);
+	}
+	if (this->cq_ring != MAP_FAILED && this->cq_ring != this->sq_ring) {
+		munmap(this->cq_ring, this->cq_ring_size);
+	}
+	if (this->sq_ring != MAP_FAILED) {
+		munmap(this->sq_ring, this->sq_ring_size);
+	}
+	if (this->ring_fd >= 0) {
+		close(this->ring_fd);
+	}
+}
+
+bool FileRing::Setup()
+{
+	memset(&this->params, 0, sizeof(this->params));
+	this->ring_fd = static_cast<int>(syscall(__NR_io_uring_setup, URING_ENTRIES, &this->params));
+	if (this->ring_fd < 0) {
+		return false;
+	}
+
+	this->sq_ring_size = this->params.sq_off.array + this->params.sq_entries * sizeof(unsigned);
+	this->cq_ring_size = this->params.cq_off.cqes + this->params.cq_entries * sizeof(io_uring_cqe);
+	this->sqes_size    = this->params.sq_entries * sizeof(io_uring_sqe);
+
+	if (this->params.features & IORING_FEAT_SINGLE_MMAP) {
+		this->sq_ring_size = this->cq_ring_size = std::max(this->sq_ring_size, this->cq_ring_size);
+	}
+
+	this->sq_ring = mmap(nullptr, this->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, this->ring_fd, IORING_OFF_SQ_RING);
+	if (this->sq_ring == MAP_FAILED) {
+		return false;
+	}
+
+	if (this->params.features & IORING_FEAT_SINGLE_MMAP) {
+		this->cq_ring = this->sq_ring;
+	} else {
+		this->cq_ring = mmap(nullptr, this->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, this->ring_fd, IORING_OFF_CQ_RING);
+		if (this->cq_ring == MAP_FAILED) {
+			return false;
+		}
+	}
+
+	this->sqes = static_cast<io_uring_sqe*>(mmap(nullptr, this->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+	                                             this->ring_fd, IORING_OFF_SQES));
+	if (this->sqes == MAP_FAILED) {
+		return false;
+	}
+
+	// Kernels that cannot open, stat and read through the ring use the thread pool instead
+	std::vector<unsigned char> probe_buffer(sizeof(io_uring_probe) + URING_PROBE_OPS * sizeof(io_uring_probe_op), 0);
+	io_uring_probe*            probe = reinterpret_cast<io_uring_probe*>(probe_buffer.data());
+	if (syscall(__NR_io_uring_register, this->ring_fd, IORING_REGISTER_PROBE, probe, URING_PROBE_OPS) < 0) {
+		return false;
+	}
+
+	for (const auto opcode : { IORING_OP_OPENAT, IORING_OP_STATX, IORING_OP_READ }) {
+		if (opcode > probe->last_op || !(probe->ops[opcode].flags & IO_URING_OP_SUPPORTED)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void FileRing::Submit(const std::function<void(io_uring_sqe&, const size_t)>& prepare, const size_t count,
+                      const std::function<void(const size_t, const int)>& complete)
+{
+	char*         sq       = static_cast<char*>(this->sq_ring);
+	char*         cq       = static_cast<char*>(this->cq_ring);
+	unsigned*     sq_tail  = reinterpret_cast<unsigned*>(sq + this->params.sq_off.tail);
+	unsigned      sq_mask  = *reinterpret_cast<unsigned*>(sq + this->params.sq_off.ring_mask);
+	unsigned*     sq_array = reinterpret_cast<unsigned*>(sq + this->params.sq_off.array);
+	unsigned*     cq_head  = reinterpret_cast<unsigned*>(cq + this->params.cq_off.head);
+	unsigned*     cq_tail  = reinterpret_cast<unsigned*>(cq + this->params.cq_off.tail);
+	unsigned      cq_mask  = *reinterpret_cast<unsigned*>(cq + this->params.cq_off.ring_mask);
+	io_uring_cqe* cqes     = reinterpret_cast<io_uring_cqe*>(cq + this->params.cq_off.cqes);
+
+	for (size_t start = 0; start < count; start += this->params.sq_entries) {
+		unsigned batch_count = static_cast<unsigned>(std::min<size_t>(this->params.sq_entries, count - start));
+		unsigned tail        = *sq_tail;
+
+		for (unsigned i = 0; i < batch_count; i++) {
+			unsigned      index = (tail + i) & sq_mask;
+			io_uring_sqe& sqe   = this->sqes[index];
+
+			memset(&sqe, 0, sizeof(sqe));
+			prepare(sqe, start + i);
+			sqe.user_data   = start + i;
+			sq_array[index] = index;
+		}
+		__atomic_store_n(sq_tail, tail + batch_count, __ATOMIC_RELEASE);
+
+		// Submission stops early at an entry that fails to prepare, which still completes with an error,
+		// so the entries after it are submitted again instead of being waited on
+		unsigned submitted = 0;
+		unsigned completed = 0;
+		while (completed < batch_count) {
+			int result = static_cast<int>(syscall(__NR_io_uring_enter, this->ring_fd, batch_count - submitted,
+			                                      batch_count - completed, IORING_ENTER_GETEVENTS, nullptr, 0));
+			if (result >= 0) {
+				submitted += static_cast<unsigned>(result);
+			} else if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+				throw std::runtime_error("Failed to submit file reads.");
+			}
+
+			unsigned head = *cq_head;
+			while (head != __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE)) {
+				const io_uring_cqe& cqe = cqes[head & cq_mask];
+				complete(static_cast<size_t>(cqe.user_data), cqe.res);
+				head++;
+				completed++;
+			}
+			__atomic_store_n(cq_head, head, __ATOMIC_RELEASE);
+		}
+	}
+}
+
+static bool ReadFilesRing(const std::vector<std::string>& file_names, const std::vector<size_t>& indexes,
+                          std::vector<std::vector<unsigned char>>& buffers, std::vector<bool>& mapped)
+{
+	FileRing ring;
+	if (!ring.Setup()) {
+		return false;
+	}
+
+	std::vector<int>            fds(indexes.size(), -1);
+	std::vector<struct statx>   stats(indexes.size());
+	std::vector<int>            stat_results(indexes.size(), 0);
+	std::vector<size_t>         pending;
+
+	auto close_files = [&]() {
+		for (auto& fd : fds) {
+			if (fd >= 0) {
+				close(fd);
+			}
+		}
+	};
+
+	try {
+		ring.Submit([&](io_uring_sqe& sqe, const size_t operation) {
+			size_t file = operation >> 1;
+			sqe.fd      = AT_FDCWD;
+			sqe.addr    = reinterpret_cast<unsigned long long>(file_names[indexes[file]].c_str());
+
+			if (operation & 1) {
+				sqe.opcode      = IORING_OP_STATX;
+				sqe.len         = STATX_TYPE | STATX_SIZE;
+				sqe.off         = reinterpret_cast<unsigned long long>(&stats[file]);
+			} else {
+				sqe.opcode      = IORING_OP_OPENAT;
+				sqe.open_flags  = O_RDONLY | O_CLOEXEC;
+			}
+		}, indexes.size() * 2, [&](const size_t operation, const int result) {
+			if (operation & 1) {
+				stat_results[operation >> 1] = result;
+			} else {
+				fds[operation >> 1] = result;
+			}
+		});
+
+		for (size_t i = 0; i < indexes.size(); i++) {
+			if (fds[i] == -EINVAL || stat_results[i] == -EINVAL) {
+				close_files();
+				return false;
+			}
+			if (fds[i] < 0) {
+				throw std::runtime_error(("Cannot open \"" + file_names[indexes[i]] + "\" for reading.").c_str());
+			}
+			// Pipes and other special files report no useful size, so they are read through to the end instead
+			if (stat_results[i] < 0 || (stats[i].stx_mask & (STATX_TYPE | STATX_SIZE)) != (STATX_TYPE | STATX_SIZE) ||
+			    !S_ISREG(stats[i].stx_mode)) {
+				pending.push_back(i);
+				continue;
+			}
+			if (stats[i].stx_size >= MAP_FILE_SIZE) {
+				mapped[indexes[i]] = true;
+				continue;
+			}
+
+			buffers[indexes[i]].resize(static_cast<size_t>(stats[i].stx_size));
+		}
+
+		std::vector<int> read_results(indexes.size(), 0);
+		ring.Submit([&](io_uring_sqe& sqe, const size_t file) {
+			std::vector<unsigned char>& buffer = buffers[indexes[file]];
+
+			sqe.opcode = IORING_OP_READ;
+			sqe.fd     = fds[file];
+			sqe.addr   = reinterpret_cast<unsigned long long>(buffer.data());
+			sqe.len    = static_cast<unsigned>(buffer.size());
+			sqe.off    = 0;
+		}, indexes.size(), [&](const size_t file, const int result) {
+			read_results[file] = result;
+		});
+
+		for (size_t i = 0; i < indexes.size(); i++) {
+			std::vector<unsigned char>& buffer = buffers[indexes[i]];
+			if (read_results[i] < 0) {
+				throw std::runtime_error(("Failed to read from \"" + file_names[indexes[i]] + "\".").c_str());
+			}
+			if (static_cast<size_t>(read_results[i]) != buffer.size() &&
+			    std::find(pending.begin(), pending.end(), i) == pending.end()) {
+				pending.push_back(i);
+			}
+		}
+	} catch (...) {
+		close_files();
+		throw;
+	}
+	close_files();
+
+	std::vector<size_t> pending_indexes;
+	for (const auto& file : pending) {
+		pending_indexes.push_back(indexes[file]);
+	}
+	if (!pending_indexes.empty()) {
+		ReadFilesParallel(file_names, pending_indexes, buffers);
+	}
+
+	return true;
+}
+
+#endif
+
+void ReadFiles(const std::vector<std::string>& file_names, std::vector<std::vector<unsigned char>>& buffers, std::vector<bool>& mapped)
+{
+	std::vector<size_t> indexes;
+
+	buffers.assign(file_names.size(), std::vector<unsigned char>());
+	mapped.assign(file_names.size(), false);
+	for (size_t i = 0; i < file_names.size(); i++) {
+		if (file_names[i].compare("-") == 0) {
+			ReadFile(file_names[i], buffers[i]);
+		} else {
+			indexes.push_back(i);
+		}
+	}
+
+	if (indexes.empty()) {
+		return;
+	}
+
+#ifdef __linux__
+	if (ReadFilesRing(file_names, indexes, buffers, mapped)) {
+		return;
+	}
+#endif
+
+	ReadFilesParallel(file_names, indexes, buffers);
+}
@@ -1,100 +1,305 @@
-/*
-	Copyright (c) 2025 Devon Artmeier
-
-	Permission to use, copy, modify, and /or distribute this software
-	for any purpose with or without fee is hereby granted.
-
-	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
-	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
-	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
-	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
-	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
-	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
-	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
-	PERFORMANCE OF THIS SOFTWARE.
-*/
-
-#include "shared.hpp"
-
-std::string StringToLower(const std::string& str)
-{
-	std::string lower_str = str;
-	std::transform(lower_str.begin(), lower_str.end(), lower_str.begin(), [](unsigned char c) { return std::tolower(c); });
-	return lower_str;
-}
-
-bool CheckArgument(const int argc, char* argv[], int& index, const std::string& option, const bool ignore_case)
-{
-	std::string option_copy = option;
-	if (ignore_case) {
-		option_copy = StringToLower(option);
-	}
-
-	if (strcmp(argv[index], ("-" + option_copy).c_str()) == 0) {
-		if (++index >= argc) {
-			throw std::runtime_error(("Missing parameter for \"-" + option + "\"").c_str());
-		}
-		return true;
-	}
-	return false;
-}
-
-void ReadInput(std::ifstream& input, char* const read_buffer, const std::streamsize read_count)
-{
-	if (read_buffer == nullptr) {
-		return;
-	}
-
-	input.read(read_buffer, read_count);
-	std::streamsize actual_read_count = input.gcount();
-
-	if (actual_read_count == 0) {
-		throw std::runtime_error("Reached end of file prematurely.");
-	} else if (actual_read_count < 0) {
-		throw std::runtime_error("Failed to read from file.");
-	}
-}
-
-bool StringStartsWith(const std::string& str, const std::string& prefix)
-{
-	return str.size() >= prefix.size() && str.compare(0, prefix.size(), prefix) == 0;
-}
-
-bool StringEndsWith(const std::string& str, const std::string& suffix)
-{
-	return str.size() >= suffix.size() && str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
-}
-
-void WriteOutputValue(std::ofstream& output, long long value, const std::string& hex_prefix, const std::string& bin_prefix,
-                      const ValueType value_type, const NumberBase number_base)
-{
-	if (value_type == ValueType::Signed32 || value_type == ValueType::Signed64) {
-		if (value < 0) {
-			output << "-";
-			value = -value;
-		} else {
-			output << " ";
-		}
-	}
-
-	if (value_type == ValueType::Unsigned32 || value_type == ValueType::Signed32) {
-		value &= 0xFFFFFFFF;
-	}
-
-	switch (number_base) {
-		case NumberBase::Hex:
-			output << hex_prefix << std::hex << std::uppercase << value;
-			break;
-		case NumberBase::Decimal:
-			output << value;
-			break;
-		case NumberBase::Binary:
-			output << bin_prefix;
-			if (value_type == ValueType::Unsigned32 || value_type == ValueType::Signed32) {
-				output << std::bitset<32>(value);
-			} else {
-				output << std::bitset<64>(value);
-			}
-			break;
-	}
-}
+/*
+	Copyright (c) 2025 Devon Artmeier
+
+	Permission to use, copy, modify, and /or distribute this software
+	for any purpose with or without fee is hereby granted.
+
+	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
+	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
+	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+	PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "shared.hpp"
+
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <fcntl.h>
+#include <io.h>
+#include <process.h>
+#include <sys/stat.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const size_t   READ_CHUNK_SIZE    = 0x10000;
+static const unsigned TEMP_FILE_ATTEMPTS = 100;
+
+std::string StringToLower(const std::string& str)
+{
+	std::string lower_str = str;
+	std::transform(lower_str.begin(), lower_str.end(), lower_str.begin(), [](unsigned char c) { return std::tolower(c); });
+	return lower_str;
+}
+
+void ReadArguments(const int argc, char* argv[], std::vector<std::string>& arguments)
+{
+	for (int i = 1; i < argc; i++) {
+		if (argv[i][0] != '@') {
+			arguments.push_back(argv[i]);
+			continue;
+		}
+
+		std::vector<unsigned char> buffer;
+		ReadFile(argv[i] + 1, buffer);
+
+		std::string argument = "";
+		bool        quoted   = false;
+		bool        pending  = false;
+
+		for (const auto& c : buffer) {
+			if (c == '"') {
+				quoted  = !quoted;
+				pending = true;
+			} else if (!quoted && std::isspace(c)) {
+				if (pending) {
+					arguments.push_back(argument);
+					argument.clear();
+					pending = false;
+				}
+			} else {
+				argument += static_cast<char>(c);
+				pending   = true;
+			}
+		}
+		if (pending) {
+			arguments.push_back(argument);
+		}
+	}
+}
+
+void SetBinaryMode(FILE* file)
+{
+#ifdef _WIN32
+	_setmode(_fileno(file), _O_BINARY);
+#else
+	(void)file;
+#endif
+}
+
+bool FileExists(const std::string& file_name)
+{
+#ifdef _WIN32
+	struct _stat64 file_stat;
+	bool           found = _stat64(file_name.c_str(), &file_stat) == 0;
+#else
+	struct stat file_stat;
+	bool        found = stat(file_name.c_str(), &file_stat) == 0;
+#endif
+	// Only a missing file may be replaced by a new one, any other failure could hide an existing file
+	if (!found && errno != ENOENT) {
+		throw std::runtime_error(("Cannot access \"" + file_name + "\".").c_str());
+	}
+	return found;
+}
+
+std::string CreateTempFile(const std::string& file_name)
+{
+	static std::atomic<unsigned> temp_count(0);
+
+	for (unsigned attempt = 0; attempt < TEMP_FILE_ATTEMPTS; attempt++) {
+#ifdef _WIN32
+		std::string temp_file_name = file_name + "." + std::to_string(_getpid()) + "." + std::to_string(temp_count++) + ".tmp";
+		int         fd             = _open(temp_file_name.c_str(), _O_WRONLY | _O_CREAT | _O_EXCL | _O_BINARY, _S_IREAD | _S_IWRITE);
+		if (fd >= 0) {
+			_close(fd);
+			return temp_file_name;
+		}
+#else
+		std::string temp_file_name = file_name + "." + std::to_string(getpid()) + "." + std::to_string(temp_count++) + ".tmp";
+		int         fd             = open(temp_file_name.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0666);
+		if (fd >= 0) {
+			close(fd);
+			return temp_file_name;
+		}
+#endif
+		if (errno != EEXIST) {
+			break;
+		}
+	}
+	throw std::runtime_error(("Cannot create a temporary file for \"" + file_name + "\".").c_str());
+}
+
+void CommitFile(const std::string& temp_file_name, const std::string& file_name)
+{
+	// The new contents must reach the disk before the rename, or a crash could leave an empty file in place of the old one
+#ifdef _WIN32
+	HANDLE file   = CreateFileA(temp_file_name.c_str(), GENERIC_WRITE, 0, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	bool   synced = file != INVALID_HANDLE_VALUE && FlushFileBuffers(file) != 0;
+	if (file != INVALID_HANDLE_VALUE) {
+		CloseHandle(file);
+	}
+#else
+	int  fd     = open(temp_file_name.c_str(), O_WRONLY | O_CLOEXEC);
+	bool synced = fd >= 0 && fsync(fd) == 0;
+	if (fd >= 0) {
+		close(fd);
+	}
+#endif
+	if (!synced) {
+		std::remove(temp_file_name.c_str());
+		throw std::runtime_error(("Cannot replace \"" + file_name + "\".").c_str());
+	}
+
+#ifdef _WIN32
+	bool replaced = MoveFileExA(temp_file_name.c_str(), file_name.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+	bool replaced = std::rename(temp_file_name.c_str(), file_name.c_str()) == 0;
+#endif
+	if (!replaced) {
+		std::remove(temp_file_name.c_str());
+		throw std::runtime_error(("Cannot replace \"" + file_name + "\".").c_str());
+	}
+}
+
+void ReadFile(const std::string& file_name, std::vector<unsigned char>& buffer)
+{
+	size_t size = 0;
+	buffer.clear();
+
+	if (file_name.compare("-") == 0) {
+		SetBinaryMode(stdin);
+		while (true) {
+			buffer.resize(size + READ_CHUNK_SIZE);
+			size_t read_count = fread(buffer.data() + size, 1, READ_CHUNK_SIZE, stdin);
+			size += read_count;
+			if (read_count < READ_CHUNK_SIZE) {
+				break;
+			}
+		}
+
+		if (ferror(stdin)) {
+			throw std::runtime_error("Failed to read from standard input.");
+		}
+	} else {
+		std::ifstream input(file_name, std::ios::in | std::ios::binary);
+		if (!input.is_open()) {
+			throw std::runtime_error(("Cannot open \"" + file_name + "\" for reading.").c_str());
+		}
+
+		while (input) {
+			buffer.resize(size + READ_CHUNK_SIZE);
+			input.read(reinterpret_cast<char*>(buffer.data() + size), READ_CHUNK_SIZE);
+			size += static_cast<size_t>(input.gcount());
+		}
+
+		if (input.bad()) {
+			throw std::runtime_error(("Failed to read from \"" + file_name + "\".").c_str());
+		}
+	}
+
+	buffer.resize(size);
+}
+
+void ReadInput(InputBuffer& input, void* const read_buffer, const size_t read_count)
+{
+	if (read_count > input.size - input.offset) {
+		throw std::runtime_error("Reached end of file prematurely.");
+	}
+
+	if (read_buffer != nullptr) {
+		memcpy(read_buffer, input.data + input.offset, read_count);
+	}
+	input.offset += read_count;
+}
+
+void SkipInput(InputBuffer& input, const size_t skip_count)
+{
+	ReadInput(input, nullptr, skip_count);
+}
+
+bool ReadInputLine(InputBuffer& input, const char*& line, size_t& length)
+{
+	if (input.offset >= input.size) {
+		return false;
+	}
+
+	const unsigned char* line_start = input.data + input.offset;
+	const unsigned char* line_end   = static_cast<const unsigned char*>(memchr(line_start, '\n', input.size - input.offset));
+
+	if (line_end == nullptr) {
+		line_end     = input.data + input.size;
+		input.offset = input.size;
+	} else {
+		input.offset = (line_end - input.data) + 1;
+	}
+	if (line_end > line_start && line_end[-1] == '\r') {
+		line_end--;
+	}
+
+	line   = reinterpret_cast<const char*>(line_start);
+	length = line_end - line_start;
+	return true;
+}
+
+bool ReadInputLine(InputBuffer& input, std::string& line)
+{
+	const char* line_start;
+	size_t      line_length;
+
+	if (!ReadInputLine(input, line_start, line_length)) {
+		return false;
+	}
+
+	line.assign(line_start, line_length);
+	return true;
+}
+
+bool ParseHexValue(const std::string& value_str, long long& value)
+{
+	std::string digits = value_str;
+	if (StringStartsWith(digits, "$")) {
+		digits = digits.substr(1);
+	} else if (StringStartsWith(StringToLower(digits), "0x")) {
+		digits = digits.substr(2);
+	}
+
+	try {
+		size_t end = 0;
+		value = static_cast<long long>(std::stoull(digits, &end, 16));
+		return end == digits.size();
+	} catch (...) {
+		return false;
+	}
+}
+
+// Psy-Q values are sign-extended, so addresses from 0x80000000 up are stored as negative values.
+// Address ranges compare them as the unsigned 32-bit addresses they were written as.
+long long NormalizeAddress(const long long value)
+{
+	if (value < 0 && value >= INT32_MIN) {
+		return value & 0xFFFFFFFFLL;
+	}
+	return value;
+}
+
+long long ParseValueOffset(const std::string& value_offset)
+{
+	long long value_offset_int = 0;
+	if (!value_offset.empty()) {
+		try {
+			value_offset_int = std::stoll(value_offset, nullptr, 16);
+		} catch (...) {
+			throw std::runtime_error(("Invalid value offset \"" + value_offset + "\".").c_str());
+		}
+	}
+	return value_offset_int;
+}
+
+bool StringStartsWith(const std::string& str, const std::string& prefix)
+{
+	return str.size() >= prefix.size() && str.compare(0, prefix.size(), prefix) == 0;
+}
+
+bool StringEndsWith(const std::string& str, const std::string& suffix)
+{
+	return str.size() >= suffix.size() && str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
@@ -1,28 +1,39 @@
-/*
-	Copyright (c) 2025 Devon Artmeier
-
-	Permission to use, copy, modify, and /or distribute this software
-	for any purpose with or without fee is hereby granted.
-
-	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
-	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
-	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
-	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
-	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
-	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
-	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
-	PERFORMANCE OF THIS SOFTWARE.
-*/
-
-#ifndef HELPERS_HPP
-#define HELPERS_HPP
-
-extern std::string StringToLower   (const std::string& str);
-extern bool        CheckArgument   (const int argc, char* argv[], int& index, const std::string& option, const bool ignore_case = true);
-extern void        ReadInput       (std::ifstream& input, char* const read_buffer, const std::streamsize read_count);
-extern bool        StringStartsWith(const std::string& str, const std::string& prefix);
-extern bool        StringEndsWith  (const std::string& str, const std::string& suffix);
-extern void        WriteOutputValue(std::ofstream& output, long long value, const std::string& hex_prefix, const std::string& bin_prefix,
-                                    const ValueType value_type, const NumberBase number_base);
-
-#endif // HELPERS_HPP
+/*
+	Copyright (c) 2025 Devon Artmeier
+
+	Permission to use, copy, modify, and /or distribute this software
+	for any purpose with or without fee is hereby granted.
+
+	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
+	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
+	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+	PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef HELPERS_HPP
+#define HELPERS_HPP
+
+extern std::string StringToLower   (const std::string& str);
+extern void        ReadArguments   (const int argc, char* argv[], std::vector<std::string>& arguments);
+extern void        SetBinaryMode   (FILE* file);
+extern bool        FileExists      (const std::string& file_name);
+extern std::string CreateTempFile  (const std::string& file_name);
+extern void        CommitFile      (const std::string& temp_file_name, const std::string& file_name);
+extern void        ReadFile        (const std::string& file_name, std::vector<unsigned char>& buffer);
+extern void        ReadFiles       (const std::vector<std::string>& file_names, std::vector<std::vector<unsigned char>>& buffers,
+                                    std::vector<bool>& mapped);
+extern void        ReadInput       (InputBuffer& input, void* const read_buffer, const size_t read_count);
+extern void        SkipInput       (InputBuffer& input, const size_t skip_count);
+extern bool        ReadInputLine   (InputBuffer& input, const char*& line, size_t& length);
+extern bool        ReadInputLine   (InputBuffer& input, std::string& line);
+extern bool        ParseHexValue   (const std::string& value_str, long long& value);
+extern long long   ParseValueOffset(const std::string& value_offset);
+extern long long   NormalizeAddress(const long long value);
+extern bool        StringStartsWith(const std::string& str, const std::string& prefix);
+extern bool        StringEndsWith  (const std::string& str, const std::string& suffix);
+
+#endif // HELPERS_HPP
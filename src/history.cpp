@@ -0,0 +1,613 @@
+/*
+	Copyright (c) 2025 Devon Artmeier
+
+	Permission to use, copy, modify, and /or distribute this software
+	for any purpose with or without fee is hereby granted.
+
+	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
+	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
+	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+	PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "shared.hpp"
+
+static const size_t HISTORY_SECTION_WIDTHS[HISTORY_SECTION_COUNT] = { 4, 1, 4, 1, 4, 4, 8, 4, 4, 4, 4 };
+static const size_t HISTORY_ALIGN                                 = 8;
+static const size_t HISTORY_WRITE_COUNT                           = 0x10000;
+static const size_t HISTORY_ADDRESS_WALK                          = 0x100;
+
+static inline size_t AlignHistoryOffset(const size_t offset)
+{
+	return (offset + HISTORY_ALIGN - 1) & ~(HISTORY_ALIGN - 1);
+}
+
+static void StoreNumber(std::ostream& output, const long long number, const int bytes)
+{
+	char write_buffer[8];
+
+	for (int i = 0; i < bytes; i++) {
+		write_buffer[i] = (number >> (i * 8)) & 0xFF;
+	}
+	output.write(write_buffer, bytes);
+}
+
+template<typename T>
+static void StoreColumn(std::ostream& output, const std::vector<T>& column, const size_t bytes)
+{
+	std::vector<char> write_buffer(HISTORY_WRITE_COUNT * bytes);
+
+	for (size_t start = 0; start < column.size(); start += HISTORY_WRITE_COUNT) {
+		size_t count = std::min(column.size() - start, HISTORY_WRITE_COUNT);
+		for (size_t i = 0; i < count; i++) {
+			unsigned long long number = static_cast<unsigned long long>(column[start + i]);
+			for (size_t j = 0; j < bytes; j++) {
+				write_buffer[(i * bytes) + j] = (number >> (j * 8)) & 0xFF;
+			}
+		}
+		output.write(write_buffer.data(), count * bytes);
+	}
+}
+
+void SymbolHistory::Open(const std::string& file_name)
+{
+	this->file_name  = file_name;
+	this->live_build = HISTORY_OPEN;
+
+#ifndef _WIN32
+	if (this->mapped_file.Open(file_name)) {
+		this->data = this->mapped_file.GetData();
+		this->size = this->mapped_file.GetSize();
+	} else
+#endif
+	{
+		ReadFile(file_name, this->buffer);
+		this->data = this->buffer.data();
+		this->size = this->buffer.size();
+	}
+
+	InputBuffer input = { this->data, this->size, 0 };
+	if (this->size < HISTORY_HEADER_SIZE || memcmp(this->data, "BSYH", 4) != 0) {
+		throw std::runtime_error(("\"" + file_name + "\" is not a valid history file.").c_str());
+	}
+
+	auto [format, build_count, name_count, version_count] = HistoryHeader::Read(input);
+	if (static_cast<size_t>(format) != HISTORY_FORMAT) {
+		throw std::runtime_error(("\"" + file_name + "\" has an unsupported history format.").c_str());
+	}
+	this->build_count   = static_cast<size_t>(build_count);
+	this->name_count    = static_cast<size_t>(name_count);
+	this->version_count = static_cast<size_t>(version_count);
+
+	this->section_counts[HISTORY_BUILD_LABEL_OFFSETS] = this->build_count + 1;
+	this->section_counts[HISTORY_NAME_OFFSETS]        = this->name_count + 1;
+	this->section_counts[HISTORY_NAME_ORDER]          = this->name_count;
+	this->section_counts[HISTORY_NAME_VERSIONS]       = this->name_count + 1;
+	this->section_counts[HISTORY_VERSION_VALUES]      = this->version_count;
+	this->section_counts[HISTORY_VERSION_NAMES]       = this->version_count;
+	this->section_counts[HISTORY_VERSION_FIRST]       = this->version_count;
+	this->section_counts[HISTORY_VERSION_END]         = this->version_count;
+	this->section_counts[HISTORY_ADDRESS_ORDER]       = this->version_count;
+
+	// Sections are only bounds checked here, queries then read straight out of the file
+	for (size_t i = 0; i < HISTORY_SECTION_COUNT; i++) {
+		auto [offset] = HistorySection::Read(input);
+		this->sections[i] = static_cast<size_t>(offset);
+
+		if (i == HISTORY_BUILD_LABELS) {
+			this->section_counts[i] = static_cast<size_t>(this->LoadNumber(HISTORY_BUILD_LABEL_OFFSETS, this->build_count));
+		} else if (i == HISTORY_NAMES) {
+			this->section_counts[i] = static_cast<size_t>(this->LoadNumber(HISTORY_NAME_OFFSETS, this->name_count));
+		}
+
+		size_t section_size = this->section_counts[i] * HISTORY_SECTION_WIDTHS[i];
+		if (this->sections[i] > this->size || section_size / HISTORY_SECTION_WIDTHS[i] != this->section_counts[i] ||
+		    section_size > this->size - this->sections[i]) {
+			throw std::runtime_error(("\"" + file_name + "\" is not a valid history file.").c_str());
+		}
+	}
+}
+
+long long SymbolHistory::LoadNumber(const HistorySectionId section, const size_t index) const
+{
+	if (index >= this->section_counts[section]) {
+		throw std::runtime_error(("\"" + this->file_name + "\" is corrupt.").c_str());
+	}
+
+	const unsigned char* number = this->data + this->sections[section] + (index * HISTORY_SECTION_WIDTHS[section]);
+	if (HISTORY_SECTION_WIDTHS[section] == 8) {
+		return std::get<0>(Integer<8>::Load(number));
+	}
+	return std::get<0>(Integer<4>::Load(number));
+}
+
+size_t SymbolHistory::GetBuildCount() const
+{
+	return this->build_count;
+}
+
+size_t SymbolHistory::GetNameCount() const
+{
+	return this->name_count;
+}
+
+size_t SymbolHistory::GetVersionCount() const
+{
+	return this->version_count;
+}
+
+std::string SymbolHistory::GetBuildLabel(const size_t build) const
+{
+	size_t start = static_cast<size_t>(this->LoadNumber(HISTORY_BUILD_LABEL_OFFSETS, build));
+	size_t end   = static_cast<size_t>(this->LoadNumber(HISTORY_BUILD_LABEL_OFFSETS, build + 1));
+
+	if (start > end || end > this->section_counts[HISTORY_BUILD_LABELS]) {
+		throw std::runtime_error(("\"" + this->file_name + "\" is corrupt.").c_str());
+	}
+	return std::string(reinterpret_cast<const char*>(this->data + this->sections[HISTORY_BUILD_LABELS] + start), end - start);
+}
+
+void SymbolHistory::GetNameData(const size_t name, const char*& text, size_t& length) const
+{
+	size_t start = static_cast<size_t>(this->LoadNumber(HISTORY_NAME_OFFSETS, name));
+	size_t end   = static_cast<size_t>(this->LoadNumber(HISTORY_NAME_OFFSETS, name + 1));
+
+	if (start > end || end > this->section_counts[HISTORY_NAMES]) {
+		throw std::runtime_error(("\"" + this->file_name + "\" is corrupt.").c_str());
+	}
+	text   = reinterpret_cast<const char*>(this->data + this->sections[HISTORY_NAMES] + start);
+	length = end - start;
+}
+
+std::string SymbolHistory::GetName(const size_t name) const
+{
+	const char* text;
+	size_t      length;
+
+	this->GetNameData(name, text, length);
+	return std::string(text, length);
+}
+
+size_t SymbolHistory::GetNameOrder(const size_t index) const
+{
+	return static_cast<size_t>(this->LoadNumber(HISTORY_NAME_ORDER, index));
+}
+
+size_t SymbolHistory::GetNameVersions(const size_t name) const
+{
+	return static_cast<size_t>(this->LoadNumber(HISTORY_NAME_VERSIONS, name));
+}
+
+long long SymbolHistory::GetVersionValue(const size_t version) const
+{
+	return this->LoadNumber(HISTORY_VERSION_VALUES, version);
+}
+
+size_t SymbolHistory::GetVersionName(const size_t version) const
+{
+	return static_cast<size_t>(this->LoadNumber(HISTORY_VERSION_NAMES, version));
+}
+
+size_t SymbolHistory::GetVersionFirst(const size_t version) const
+{
+	return static_cast<size_t>(this->LoadNumber(HISTORY_VERSION_FIRST, version));
+}
+
+size_t SymbolHistory::GetVersionEnd(const size_t version) const
+{
+	return static_cast<size_t>(this->LoadNumber(HISTORY_VERSION_END, version));
+}
+
+size_t SymbolHistory::GetAddressOrder(const size_t index) const
+{
+	return static_cast<size_t>(this->LoadNumber(HISTORY_ADDRESS_ORDER, index));
+}
+
+bool SymbolHistory::FindName(const std::string& name, size_t& name_id) const
+{
+	size_t low  = 0;
+	size_t high = this->name_count;
+
+	while (low < high) {
+		size_t      middle = low + ((high - low) / 2);
+		const char* text;
+		size_t      length;
+
+		this->GetNameData(this->GetNameOrder(middle), text, length);
+		int compare = name.compare(0, std::string::npos, text, length);
+		if (compare == 0) {
+			name_id = this->GetNameOrder(middle);
+			return true;
+		}
+		if (compare > 0) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+	return false;
+}
+
+size_t SymbolHistory::FindBuild(const std::string& build) const
+{
+	if (this->build_count == 0) {
+		throw std::runtime_error(("\"" + this->file_name + "\" has no builds.").c_str());
+	}
+	if (build.empty()) {
+		return this->build_count - 1;
+	}
+
+	if (build.find_first_not_of("0123456789") == std::string::npos) {
+		try {
+			size_t index = std::stoull(build);
+			if (index < this->build_count) {
+				return index;
+			}
+		} catch (...) {
+		}
+	}
+	for (size_t i = this->build_count; i-- > 0;) {
+		if (this->GetBuildLabel(i).compare(build) == 0) {
+			return i;
+		}
+	}
+	throw std::runtime_error(("Build \"" + build + "\" not found in \"" + this->file_name + "\".").c_str());
+}
+
+void SymbolHistory::WriteBuild(std::ostream& output, const size_t build) const
+{
+	output << "build " << build << " (" << this->GetBuildLabel(build) << ")";
+}
+
+void SymbolHistory::WriteNameHistory(std::ostream& output, const std::string& name) const
+{
+	size_t name_id;
+	if (!this->FindName(name, name_id)) {
+		throw std::runtime_error(("Symbol \"" + name + "\" not found in \"" + this->file_name + "\".").c_str());
+	}
+
+	size_t first_version = this->GetNameVersions(name_id);
+	size_t last_version  = this->GetNameVersions(name_id + 1);
+
+	output << name << ":" << std::endl;
+	for (size_t version = first_version; version < last_version; version++) {
+		output << "    ";
+		this->WriteBuild(output, this->GetVersionFirst(version));
+		output << ": $" << std::uppercase << std::hex << static_cast<unsigned long long>(this->GetVersionValue(version)) << std::dec << std::endl;
+
+		// A version that ends without the next one starting in the same build was removed in between
+		size_t end = this->GetVersionEnd(version);
+		if (end != HISTORY_OPEN && (version + 1 >= last_version || this->GetVersionFirst(version + 1) != end)) {
+			output << "    ";
+			this->WriteBuild(output, end);
+			output << ": removed" << std::endl;
+		}
+	}
+}
+
+bool SymbolHistory::IsVersionLive(const size_t version, const size_t build) const
+{
+	return this->GetVersionFirst(version) <= build && build < this->GetVersionEnd(version);
+}
+
+const std::vector<size_t>& SymbolHistory::GetLiveAddresses(const size_t build) const
+{
+	// Built once per build, so further lookups in the same build only search it
+	if (this->live_build != build) {
+		this->live_addresses.clear();
+		for (size_t i = 0; i < this->version_count; i++) {
+			if (this->IsVersionLive(this->GetAddressOrder(i), build)) {
+				this->live_addresses.push_back(i);
+			}
+		}
+		this->live_build = build;
+	}
+	return this->live_addresses;
+}
+
+void SymbolHistory::WriteAddressSymbols(std::ostream& output, const size_t build, const long long address) const
+{
+	// Find the first version above the address, then walk back to the nearest value present in the build
+	size_t low  = 0;
+	size_t high = this->version_count;
+
+	while (low < high) {
+		size_t middle = low + ((high - low) / 2);
+		if (this->GetVersionValue(this->GetAddressOrder(middle)) <= address) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+
+	std::vector<size_t> versions;
+	long long           value = 0;
+	size_t              steps = 0;
+	size_t              i     = low;
+
+	for (; i > 0 && steps < HISTORY_ADDRESS_WALK; i--, steps++) {
+		size_t    version       = this->GetAddressOrder(i - 1);
+		long long version_value = this->GetVersionValue(version);
+
+		if (!versions.empty() && version_value != value) {
+			break;
+		}
+		if (this->IsVersionLive(version, build)) {
+			versions.push_back(version);
+			value = version_value;
+		}
+	}
+
+	// Long runs of versions from other builds are skipped with an index of the versions alive in the build
+	if (i > 0 && steps == HISTORY_ADDRESS_WALK) {
+		const std::vector<size_t>& live_addresses = this->GetLiveAddresses(build);
+
+		versions.clear();
+		for (auto live = std::lower_bound(live_addresses.begin(), live_addresses.end(), low); live != live_addresses.begin();) {
+			size_t    version       = this->GetAddressOrder(*--live);
+			long long version_value = this->GetVersionValue(version);
+
+			if (!versions.empty() && version_value != value) {
+				break;
+			}
+			versions.push_back(version);
+			value = version_value;
+		}
+	}
+
+	std::vector<std::string> names;
+	for (const auto& version : versions) {
+		names.push_back(this->GetName(this->GetVersionName(version)));
+	}
+	std::sort(names.begin(), names.end());
+
+	output << "$" << std::uppercase << std::hex << static_cast<unsigned long long>(address) << std::dec << " in ";
+	this->WriteBuild(output, build);
+	output << ":" << std::endl;
+
+	if (names.empty()) {
+		output << "    No symbols at or below address" << std::endl;
+	}
+	for (const auto& name : names) {
+		output << "    " << name << " $" << std::uppercase << std::hex << static_cast<unsigned long long>(value);
+		if (address != value) {
+			output << " + $" << static_cast<unsigned long long>(address - value);
+		}
+		output << std::dec << std::endl;
+	}
+}
+
+void Symbols::AppendHistory(const std::string& file_name, const std::string& build_label)
+{
+	long long value_offset_int = ParseValueOffset(this->value_offset);
+
+	SymbolHistory history;
+	if (FileExists(file_name)) {
+		history.Open(file_name);
+	}
+
+	size_t build        = history.GetBuildCount();
+	size_t old_names    = history.GetNameCount();
+	size_t old_versions = history.GetVersionCount();
+
+	std::vector<std::string>                names;
+	std::unordered_map<std::string, size_t> name_ids;
+
+	names.reserve(old_names);
+	name_ids.reserve(old_names);
+	for (size_t i = 0; i < old_names; i++) {
+		names.push_back(history.GetName(i));
+		name_ids.emplace(names.back(), i);
+	}
+
+	// Names are interned in order of first appearance, so existing name IDs never change
+	std::vector<long long> new_values(old_names, 0);
+	std::vector<bool>      present(old_names, false);
+
+	this->ForEachOutputSymbol([&](const Symbol& symbol) {
+		auto [name_id, added] = name_ids.emplace(symbol.name, names.size());
+		if (added) {
+			names.push_back(symbol.name);
+			new_values.push_back(0);
+			present.push_back(false);
+		}
+		new_values[name_id->second] = symbol.value + value_offset_int;
+		present[name_id->second]    = true;
+	});
+
+	// Versions stay grouped by name, a name only gets a new version when its value changes
+	std::vector<size_t>    name_versions;
+	std::vector<long long> values;
+	std::vector<size_t>    version_names;
+	std::vector<size_t>    firsts;
+	std::vector<size_t>    ends;
+	std::vector<size_t>    version_map(old_versions);
+	std::vector<size_t>    new_versions;
+
+	name_versions.reserve(names.size() + 1);
+	for (size_t name = 0; name < names.size(); name++) {
+		name_versions.push_back(values.size());
+
+		if (name < old_names) {
+			size_t last_version = history.GetNameVersions(name + 1);
+			for (size_t version = history.GetNameVersions(name); version < last_version; version++) {
+				values.push_back(history.GetVersionValue(version));
+				version_names.push_back(name);
+				firsts.push_back(history.GetVersionFirst(version));
+				ends.push_back(history.GetVersionEnd(version));
+				version_map[version] = values.size() - 1;
+			}
+		}
+
+		bool open = name_versions.back() < values.size() && ends.back() == HISTORY_OPEN;
+		if (open && present[name] && values.back() == new_values[name]) {
+			continue;
+		}
+		if (open) {
+			ends.back() = build;
+		}
+		if (present[name]) {
+			new_versions.push_back(values.size());
+			values.push_back(new_values[name]);
+			version_names.push_back(name);
+			firsts.push_back(build);
+			ends.push_back(HISTORY_OPEN);
+		}
+	}
+	name_versions.push_back(values.size());
+
+	if (build + 1 >= HISTORY_OPEN || names.size() >= HISTORY_OPEN || values.size() >= HISTORY_OPEN) {
+		throw std::runtime_error(("\"" + file_name + "\" cannot hold any more builds.").c_str());
+	}
+
+	// The existing indexes are still in order, so only the additions are sorted and merged into them
+	auto compare_versions = [&](const size_t version_1, const size_t version_2) {
+		if (values[version_1] != values[version_2]) {
+			return values[version_1] < values[version_2];
+		}
+		if (version_names[version_1] != version_names[version_2]) {
+			return version_names[version_1] < version_names[version_2];
+		}
+		return firsts[version_1] < firsts[version_2];
+	};
+	std::sort(new_versions.begin(), new_versions.end(), compare_versions);
+
+	std::vector<size_t> address_order;
+	address_order.reserve(values.size());
+	for (size_t i = 0, next_version = 0; i <= old_versions; i++) {
+		size_t version = values.size();
+		if (i < old_versions) {
+			size_t old_version = history.GetAddressOrder(i);
+			if (old_version >= old_versions) {
+				throw std::runtime_error(("\"" + file_name + "\" is corrupt.").c_str());
+			}
+			version = version_map[old_version];
+		}
+		while (next_version < new_versions.size() && (i == old_versions || compare_versions(new_versions[next_version], version))) {
+			address_order.push_back(new_versions[next_version++]);
+		}
+		if (i < old_versions) {
+			address_order.push_back(version);
+		}
+	}
+
+	std::vector<size_t> new_names;
+	for (size_t name = old_names; name < names.size(); name++) {
+		new_names.push_back(name);
+	}
+	std::sort(new_names.begin(), new_names.end(), [&](const size_t name_1, const size_t name_2) {
+		return names[name_1] < names[name_2];
+	});
+
+	std::vector<size_t> name_order;
+	name_order.reserve(names.size());
+	for (size_t i = 0, next_name = 0; i <= old_names; i++) {
+		size_t name = i < old_names ? history.GetNameOrder(i) : 0;
+		if (name >= std::max<size_t>(old_names, 1)) {
+			throw std::runtime_error(("\"" + file_name + "\" is corrupt.").c_str());
+		}
+		while (next_name < new_names.size() && (i == old_names || names[new_names[next_name]] < names[name])) {
+			name_order.push_back(new_names[next_name++]);
+		}
+		if (i < old_names) {
+			name_order.push_back(name);
+		}
+	}
+
+	std::string label = build_label;
+	if (label.empty()) {
+		for (const auto& input_file_name : this->input_file_names) {
+			label += (label.empty() ? "" : ", ") + input_file_name;
+		}
+	}
+
+	std::vector<size_t> label_offsets;
+	std::string         labels;
+	for (size_t i = 0; i <= build; i++) {
+		label_offsets.push_back(labels.size());
+		labels += i < build ? history.GetBuildLabel(i) : label;
+	}
+	label_offsets.push_back(labels.size());
+
+	std::vector<size_t> name_offsets;
+	std::string         name_data;
+	name_offsets.reserve(names.size() + 1);
+	for (const auto& name : names) {
+		name_offsets.push_back(name_data.size());
+		name_data += name;
+	}
+	name_offsets.push_back(name_data.size());
+
+	if (labels.size() >= HISTORY_OPEN || name_data.size() >= HISTORY_OPEN) {
+		throw std::runtime_error(("\"" + file_name + "\" cannot hold any more builds.").c_str());
+	}
+
+	size_t section_sizes[HISTORY_SECTION_COUNT] = {
+		label_offsets.size(), labels.size(), name_offsets.size(), name_data.size(), name_order.size(), name_versions.size(),
+		values.size(), version_names.size(), firsts.size(), ends.size(), address_order.size()
+	};
+	size_t section_offsets[HISTORY_SECTION_COUNT];
+	size_t offset = AlignHistoryOffset(HISTORY_HEADER_SIZE + (HISTORY_SECTION_COUNT * 8));
+
+	for (size_t i = 0; i < HISTORY_SECTION_COUNT; i++) {
+		section_offsets[i] = offset;
+		offset             = AlignHistoryOffset(offset + (section_sizes[i] * HISTORY_SECTION_WIDTHS[i]));
+	}
+
+	std::string   temp_file_name = CreateTempFile(file_name);
+	std::ofstream output(temp_file_name, std::ios::out | std::ios::binary);
+	if (!output.is_open()) {
+		std::remove(temp_file_name.c_str());
+		throw std::runtime_error(("Cannot open \"" + temp_file_name + "\" for writing.").c_str());
+	}
+
+	size_t position = HISTORY_HEADER_SIZE + (HISTORY_SECTION_COUNT * 8);
+	auto begin_section = [&](const size_t section) {
+		static const char padding[HISTORY_ALIGN] = {};
+		output.write(padding, section_offsets[section] - position);
+		position = section_offsets[section] + (section_sizes[section] * HISTORY_SECTION_WIDTHS[section]);
+	};
+
+	output.write("BSYH", 4);
+	StoreNumber(output, HISTORY_FORMAT, 4);
+	StoreNumber(output, build + 1, 4);
+	StoreNumber(output, names.size(), 4);
+	StoreNumber(output, values.size(), 4);
+	for (size_t i = 0; i < HISTORY_SECTION_COUNT; i++) {
+		StoreNumber(output, section_offsets[i], 8);
+	}
+
+	begin_section(HISTORY_BUILD_LABEL_OFFSETS);
+	StoreColumn(output, label_offsets, 4);
+	begin_section(HISTORY_BUILD_LABELS);
+	output.write(labels.data(), labels.size());
+	begin_section(HISTORY_NAME_OFFSETS);
+	StoreColumn(output, name_offsets, 4);
+	begin_section(HISTORY_NAMES);
+	output.write(name_data.data(), name_data.size());
+	begin_section(HISTORY_NAME_ORDER);
+	StoreColumn(output, name_order, 4);
+	begin_section(HISTORY_NAME_VERSIONS);
+	StoreColumn(output, name_versions, 4);
+	begin_section(HISTORY_VERSION_VALUES);
+	StoreColumn(output, values, 8);
+	begin_section(HISTORY_VERSION_NAMES);
+	StoreColumn(output, version_names, 4);
+	begin_section(HISTORY_VERSION_FIRST);
+	StoreColumn(output, firsts, 4);
+	begin_section(HISTORY_VERSION_END);
+	StoreColumn(output, ends, 4);
+	begin_section(HISTORY_ADDRESS_ORDER);
+	StoreColumn(output, address_order, 4);
+	output.close();
+
+	if (output.fail()) {
+		std::remove(temp_file_name.c_str());
+		throw std::runtime_error("Failed to write output.");
+	}
+	CommitFile(temp_file_name, file_name);
+}
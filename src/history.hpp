@@ -0,0 +1,88 @@
+/*
+	Copyright (c) 2025 Devon Artmeier
+
+	Permission to use, copy, modify, and /or distribute this software
+	for any purpose with or without fee is hereby granted.
+
+	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
+	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
+	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+	PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef HISTORY_HPP
+#define HISTORY_HPP
+
+// A history store keeps the symbols of every ingested build. Names are stored once, and each name
+// has a list of versions, one for every span of builds where its value stayed the same. Builds only
+// add versions for the symbols that were added or moved, and close the versions of removed symbols.
+
+static const size_t HISTORY_FORMAT      = 1;
+static const size_t HISTORY_HEADER_SIZE = 20;
+static const size_t HISTORY_OPEN        = 0xFFFFFFFF;
+
+enum HistorySectionId
+{
+	HISTORY_BUILD_LABEL_OFFSETS,
+	HISTORY_BUILD_LABELS,
+	HISTORY_NAME_OFFSETS,
+	HISTORY_NAMES,
+	HISTORY_NAME_ORDER,
+	HISTORY_NAME_VERSIONS,
+	HISTORY_VERSION_VALUES,
+	HISTORY_VERSION_NAMES,
+	HISTORY_VERSION_FIRST,
+	HISTORY_VERSION_END,
+	HISTORY_ADDRESS_ORDER,
+	HISTORY_SECTION_COUNT
+};
+
+class SymbolHistory
+{
+public:
+	void        Open              (const std::string& file_name);
+	size_t      GetBuildCount     () const;
+	size_t      GetNameCount      () const;
+	size_t      GetVersionCount   () const;
+	std::string GetBuildLabel     (const size_t build) const;
+	std::string GetName           (const size_t name) const;
+	size_t      GetNameOrder      (const size_t index) const;
+	size_t      GetNameVersions   (const size_t name) const;
+	long long   GetVersionValue   (const size_t version) const;
+	size_t      GetVersionName    (const size_t version) const;
+	size_t      GetVersionFirst   (const size_t version) const;
+	size_t      GetVersionEnd     (const size_t version) const;
+	size_t      GetAddressOrder   (const size_t index) const;
+	bool        FindName          (const std::string& name, size_t& name_id) const;
+	size_t      FindBuild         (const std::string& build) const;
+	void        WriteNameHistory  (std::ostream& output, const std::string& name) const;
+	void        WriteAddressSymbols(std::ostream& output, const size_t build, const long long address) const;
+
+private:
+	long long                  LoadNumber      (const HistorySectionId section, const size_t index) const;
+	void                       GetNameData     (const size_t name, const char*& text, size_t& length) const;
+	void                       WriteBuild      (std::ostream& output, const size_t build) const;
+	bool                       IsVersionLive   (const size_t version, const size_t build) const;
+	const std::vector<size_t>& GetLiveAddresses(const size_t build) const;
+
+	std::string                 file_name { "" };
+#ifndef _WIN32
+	MappedFile                  mapped_file;
+#endif
+	std::vector<unsigned char>  buffer;
+	const unsigned char*        data          { nullptr };
+	size_t                      size          { 0 };
+	size_t                      build_count   { 0 };
+	size_t                      name_count    { 0 };
+	size_t                      version_count { 0 };
+	size_t                      sections[HISTORY_SECTION_COUNT]       = {};
+	size_t                      section_counts[HISTORY_SECTION_COUNT] = {};
+	mutable size_t              live_build    { HISTORY_OPEN };
+	mutable std::vector<size_t> live_addresses;
+};
+
+#endif // HISTORY_HPP
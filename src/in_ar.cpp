@@ -0,0 +1,181 @@
+/*
+	Copyright (c) 2025 Devon Artmeier
+
+	Permission to use, copy, modify, and /or distribute this software
+	for any purpose with or without fee is hereby granted.
+
+	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
+	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
+	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+	PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "shared.hpp"
+
+static const size_t ARCHIVE_HEADER_SIZE = 60;
+
+struct ArchiveMember
+{
+	std::string          name;
+	const unsigned char* data;
+	size_t               size;
+};
+
+static size_t ReadHeaderNumber(const unsigned char* field, const size_t length, const int base)
+{
+	std::string number(reinterpret_cast<const char*>(field), length);
+	size_t      end = number.find_last_not_of(' ');
+
+	if (end == std::string::npos) {
+		throw std::runtime_error("Invalid archive member header.");
+	}
+	try {
+		return static_cast<size_t>(std::stoull(number.substr(0, end + 1), nullptr, base));
+	} catch (...) {
+		throw std::runtime_error("Invalid archive member header.");
+	}
+}
+
+static void ReadArchiveMembers(InputBuffer& input, std::vector<ArchiveMember>& members)
+{
+	const unsigned char* long_names      = nullptr;
+	size_t               long_names_size = 0;
+
+	while (input.offset < input.size) {
+		if (input.size - input.offset < ARCHIVE_HEADER_SIZE) {
+			throw std::runtime_error("Reached end of file prematurely.");
+		}
+
+		const unsigned char* header = input.data + input.offset;
+		if (header[58] != '`' || header[59] != '\n') {
+			throw std::runtime_error(("Invalid archive member header at offset " + std::to_string(input.offset) + ".").c_str());
+		}
+		SkipInput(input, ARCHIVE_HEADER_SIZE);
+
+		size_t size = ReadHeaderNumber(header + 48, 10, 10);
+		if (size > input.size - input.offset) {
+			throw std::runtime_error("Reached end of file prematurely.");
+		}
+
+		ArchiveMember member = { std::string(reinterpret_cast<const char*>(header), 16), input.data + input.offset, size };
+		member.name.erase(member.name.find_last_not_of(' ') + 1);
+
+		if (member.name.compare("/") == 0 || member.name.compare("/SYM64/") == 0 || StringStartsWith(member.name, "__.SYMDEF")) {
+			member.name.clear();
+		} else if (member.name.compare("//") == 0) {
+			long_names      = member.data;
+			long_names_size = member.size;
+			member.name.clear();
+		} else if (StringStartsWith(member.name, "#1/")) {
+			size_t name_length = ReadHeaderNumber(header + 3, 13, 10);
+			if (name_length > member.size) {
+				throw std::runtime_error("Invalid archive member header.");
+			}
+			member.name.assign(reinterpret_cast<const char*>(member.data), name_length);
+			member.name.erase(member.name.find_last_not_of('\0') + 1);
+			member.data += name_length;
+			member.size -= name_length;
+		} else if (member.name.size() > 1 && member.name[0] == '/') {
+			size_t name_offset = ReadHeaderNumber(header + 1, 15, 10);
+			if (long_names == nullptr || name_offset >= long_names_size) {
+				throw std::runtime_error("Invalid archive long member name.");
+			}
+
+			const char* name_start = reinterpret_cast<const char*>(long_names + name_offset);
+			const char* name_end   = static_cast<const char*>(memchr(name_start, '\n', long_names_size - name_offset));
+			member.name.assign(name_start, name_end != nullptr ? name_end : reinterpret_cast<const char*>(long_names + long_names_size));
+			if (!member.name.empty() && member.name.back() == '/') {
+				member.name.pop_back();
+			}
+		} else if (!member.name.empty() && member.name.back() == '/') {
+			member.name.pop_back();
+		}
+
+		if (!member.name.empty()) {
+			members.push_back(member);
+		}
+		SkipInput(input, std::min(size + (size & 1), input.size - input.offset));
+	}
+}
+
+void Symbols::AddArchiveMember(const std::string& member)
+{
+	if (member.empty() || member.compare("*") == 0) {
+		throw std::runtime_error(("Invalid archive member \"" + member + "\".").c_str());
+	}
+	this->archive_members.push_back(member);
+}
+
+bool Symbols::IsArchiveMemberIncluded(const std::string& member)
+{
+	if (this->archive_members.empty()) {
+		return true;
+	}
+
+	for (const auto& archive_member : this->archive_members) {
+		if (archive_member.back() == '*') {
+			if (member.compare(0, archive_member.size() - 1, archive_member, 0, archive_member.size() - 1) == 0) {
+				return true;
+			}
+		} else if (member.compare(archive_member) == 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool Symbols::LoadArchiveSymbols(const std::string& file_name, InputBuffer& input)
+{
+	if (input.size < 8 || memcmp(input.data, "!<arch>\n", 8) != 0) {
+		return false;
+	}
+	SkipInput(input, 8);
+
+	std::vector<ArchiveMember> members;
+	ReadArchiveMembers(input, members);
+	members.erase(std::remove_if(members.begin(), members.end(), [&](const ArchiveMember& member) {
+		return !this->IsArchiveMemberIncluded(member.name);
+	}), members.end());
+
+	// Members are decoded in place and in parallel, then added in archive order
+	std::vector<std::vector<Symbol>> member_symbols(members.size());
+	std::vector<std::exception_ptr>  errors(members.size());
+	std::atomic<size_t>              next_member(0);
+	size_t                           thread_count = std::min<size_t>(std::max(1U, std::thread::hardware_concurrency()), members.size());
+
+	auto decode_members = [&]() {
+		size_t member;
+		while ((member = next_member++) < members.size()) {
+			try {
+				InputBuffer member_input = { members[member].data, members[member].size, 0 };
+				DecodeVasmVobjSymbols(member_input, member_symbols[member]);
+			} catch (std::exception& e) {
+				errors[member] = std::make_exception_ptr(std::runtime_error(("\"" + members[member].name + "\" in \"" + file_name + "\": " + e.what()).c_str()));
+			}
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (size_t i = 1; i < thread_count; i++) {
+		threads.emplace_back(decode_members);
+	}
+	decode_members();
+	for (auto& thread : threads) {
+		thread.join();
+	}
+
+	for (size_t i = 0; i < members.size(); i++) {
+		if (errors[i]) {
+			std::rethrow_exception(errors[i]);
+		}
+		for (const auto& symbol : member_symbols[i]) {
+			this->AddSymbol(symbol.name, symbol.value);
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,209 @@
+/*
+	Copyright (c) 2025 Devon Artmeier
+
+	Permission to use, copy, modify, and /or distribute this software
+	for any purpose with or without fee is hereby granted.
+
+	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
+	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
+	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+	PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "shared.hpp"
+
+enum class LinkerMap
+{
+	None,
+	Gnu,
+	Vlink
+};
+
+// First lines GNU ld can start a map file with, depending on what the link involved
+static const char* const gnu_map_headers[] = {
+	"Archive member included",
+	"As-needed library included",
+	"Allocating common symbols",
+	"Discarded input sections",
+	"There are no discarded input sections",
+	"Merging program properties",
+	"Memory Configuration"
+};
+
+static bool LineStartsWith(const char* line, const size_t length, const char* prefix)
+{
+	size_t prefix_length = strlen(prefix);
+	return length >= prefix_length && memcmp(line, prefix, prefix_length) == 0;
+}
+
+static const char* SkipSpaces(const char* cursor, const char* end)
+{
+	while (cursor < end && (*cursor == ' ' || *cursor == '\t')) {
+		cursor++;
+	}
+	return cursor;
+}
+
+static bool ReadHexNumber(const char*& cursor, const char* end, long long& value)
+{
+	if (end - cursor >= 2 && cursor[0] == '0' && (cursor[1] == 'x' || cursor[1] == 'X')) {
+		cursor += 2;
+	}
+
+	const char*        digits_start = cursor;
+	unsigned long long number       = 0;
+
+	while (cursor < end && std::isxdigit(static_cast<unsigned char>(*cursor))) {
+		number = (number << 4) | (std::isdigit(static_cast<unsigned char>(*cursor)) ? (*cursor - '0') : ((*cursor | 0x20) - 'a' + 10));
+		cursor++;
+	}
+
+	value = static_cast<long long>(number);
+	return cursor > digits_start && cursor - digits_start <= 16;
+}
+
+static LinkerMap GetLinkerMapType(const char* line, const size_t length)
+{
+	for (const auto& header : gnu_map_headers) {
+		if (LineStartsWith(line, length, header)) {
+			return LinkerMap::Gnu;
+		}
+	}
+	if (LineStartsWith(line, length, "Files:") || LineStartsWith(line, length, "Section mapping")) {
+		return LinkerMap::Vlink;
+	}
+	return LinkerMap::None;
+}
+
+// "<address> <name>" or "<address> <name> = <expression>" under an output section, indented past the
+// section columns. Input section continuation lines have a size in place of the name and are skipped.
+static bool ParseGnuMapSymbol(const char* line, const size_t length, std::string& name, long long& value)
+{
+	const char* end    = line + length;
+	const char* cursor = SkipSpaces(line, end);
+
+	if (cursor == line || end - cursor < 3 || cursor[0] != '0' || cursor[1] != 'x' || !ReadHexNumber(cursor, end, value)) {
+		return false;
+	}
+
+	const char* name_start = SkipSpaces(cursor, end);
+	if (name_start == cursor || name_start == end) {
+		return false;
+	}
+
+	bool provided = false;
+	for (const char* provide : { "PROVIDE (", "PROVIDE_HIDDEN (" }) {
+		if (LineStartsWith(name_start, end - name_start, provide)) {
+			name_start += strlen(provide);
+			provided    = true;
+			break;
+		}
+	}
+
+	const char* name_end = name_start;
+	while (name_end < end && *name_end != ' ' && *name_end != '\t' && *name_end != '=' && *name_end != '(' && *name_end != ')' &&
+	       *name_end != ',') {
+		name_end++;
+	}
+
+	size_t name_length = name_end - name_start;
+	if (name_length == 0 || (name_length == 1 && *name_start == '.') || (name_length >= 2 && name_start[0] == '0' && name_start[1] == 'x')) {
+		return false;
+	}
+
+	const char* rest = SkipSpaces(name_end, end);
+	if (provided ? (rest == end || *rest != '=') : (rest != end && *rest != '=')) {
+		return false;
+	}
+
+	name.assign(name_start, name_length);
+	return true;
+}
+
+// "<address> <name>: <binding> ..." in a "Symbols of <section>:" or "Linker symbols:" block
+static bool ParseVlinkMapSymbol(const char* line, const size_t length, std::string& name, long long& value)
+{
+	const char* end    = line + length;
+	const char* cursor = SkipSpaces(line, end);
+
+	if (cursor == line || !ReadHexNumber(cursor, end, value)) {
+		return false;
+	}
+
+	const char* name_start = SkipSpaces(cursor, end);
+	const char* name_end   = name_start;
+	if (name_start == cursor) {
+		return false;
+	}
+
+	while (name_end < end && *name_end != ':' && *name_end != ' ' && *name_end != '\t') {
+		name_end++;
+	}
+	if (name_end == name_start || name_end == end || *name_end != ':') {
+		return false;
+	}
+
+	// Local symbols of different objects may share names
+	const char* binding = SkipSpaces(name_end + 1, end);
+	if (LineStartsWith(binding, end - binding, "local")) {
+		return false;
+	}
+
+	name.assign(name_start, name_end - name_start);
+	return true;
+}
+
+bool Symbols::LoadLinkerMapSymbols(const std::string&, InputBuffer& input)
+{
+	const char* line;
+	size_t      length;
+	LinkerMap   map_type = LinkerMap::None;
+
+	while (ReadInputLine(input, line, length)) {
+		if (length != 0) {
+			map_type = GetLinkerMapType(line, length);
+			break;
+		}
+	}
+	if (map_type == LinkerMap::None) {
+		return false;
+	}
+
+	std::string name;
+	long long   value;
+	bool        in_symbols = false;
+
+	while (ReadInputLine(input, line, length)) {
+		if (length == 0) {
+			continue;
+		}
+
+		// Section headers start at the first column, symbols are always indented
+		if (line[0] != ' ' && line[0] != '\t') {
+			if (map_type == LinkerMap::Gnu) {
+				if (LineStartsWith(line, length, "Linker script and memory map")) {
+					in_symbols = true;
+				} else if (LineStartsWith(line, length, "Cross Reference Table")) {
+					break;
+				}
+			} else {
+				in_symbols = (LineStartsWith(line, length, "Symbols of ") || LineStartsWith(line, length, "Linker symbols")) &&
+				             line[length - 1] == ':';
+			}
+			continue;
+		}
+
+		if (in_symbols) {
+			bool found = map_type == LinkerMap::Gnu ? ParseGnuMapSymbol(line, length, name, value) : ParseVlinkMapSymbol(line, length, name, value);
+			if (found) {
+				this->AddSymbol(name, value);
+			}
+		}
+	}
+
+	return true;
+}
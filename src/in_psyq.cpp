@@ -1,97 +1,89 @@
-/*
-	Copyright (c) 2025 Devon Artmeier
-
-	Permission to use, copy, modify, and /or distribute this software
-	for any purpose with or without fee is hereby granted.
-
-	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
-	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
-	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
-	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
-	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
-	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
-	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
-	PERFORMANCE OF THIS SOFTWARE.
-*/
-
-#include "shared.hpp"
-
-static long long ReadInputNumber(std::ifstream& input, bool is_signed)
-{
-	unsigned char read_buffer[4] = { 0 };
-	long long     value          = 0;
-
-	ReadInput(input, reinterpret_cast<char*>(read_buffer), 4);
-	for (int i = 3; i >= 0; i--) {
-		value = (value << 8) | read_buffer[i];
-	}
-
-	if (is_signed && (value & (1LL << 31))) {
-		value |= ~(static_cast<long long>(1LL << 32) - 1);
-	}
-
-	return value;
-}
-
-static std::string ReadInputString(std::ifstream& input)
-{
-	unsigned char char_count;
-	ReadInput(input, reinterpret_cast<char*>(&char_count), 1);
-
-	char* string_buffer = new char[char_count + 1];
-	ReadInput(input, string_buffer, char_count);
-	string_buffer[char_count] = '\0';
-
-	std::string string = string_buffer;
-	delete[] string_buffer;
-
-	return string;
-}
-
-bool Symbols::LoadPsyqSymbols(const std::string& file_name)
-{
-	std::ifstream input(file_name, std::ios::in | std::ios::binary);
-	if (!input.is_open()) {
-		throw std::runtime_error(("Cannot open \"" + file_name + "\" for reading.").c_str());
-	}
-
-	input.seekg(0, std::ios::end);
-	if (input.tellg() == 0) {
-		return false;
-	}
-	input.seekg(0, std::ios::beg);
-
-	char read_buffer[4];
-	ReadInput(input, read_buffer, 3);
-	read_buffer[3] = '\0';
-
-	if (strcmp(read_buffer, "MND")) {
-		return false;
-	}
-
-	ReadInput(input, read_buffer, 1);
-	if (read_buffer[0] != 1) {
-		return false;
-	}
-
-	input.seekg(8, std::ios_base::beg);
-
-	while (true) {
-		if (input.peek() == -1) {
-			break;
-		}
-
-		long long value = ReadInputNumber(input, true);
-
-		char type;
-		ReadInput(input, &type, 1);
-
-		std::string name = ReadInputString(input);
-
-		if (type == 1 || type == 2) {
-			this->AddSymbol(name, value);
-		}
-	}
-
-	return true;
-}
+/*
+	Copyright (c) 2025 Devon Artmeier
+
+	Permission to use, copy, modify, and /or distribute this software
+	for any purpose with or without fee is hereby granted.
+
+	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
+	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
+	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+	PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "shared.hpp"
+
+enum PsyqRecord
+{
+	PSYQ_SYMBOL      = 0x01,
+	PSYQ_LABEL       = 0x02,
+	PSYQ_LINE_INC    = 0x80,
+	PSYQ_LINE_ADD8   = 0x82,
+	PSYQ_LINE_ADD16  = 0x84,
+	PSYQ_LINE_SET    = 0x86,
+	PSYQ_LINE_FILE   = 0x88,
+	PSYQ_LINE_END    = 0x8A,
+	PSYQ_FUNC_START  = 0x8C,
+	PSYQ_FUNC_END    = 0x8E,
+	PSYQ_BLOCK_START = 0x90,
+	PSYQ_BLOCK_END   = 0x92,
+	PSYQ_DEF         = 0x94,
+	PSYQ_DEF_2       = 0x96,
+	PSYQ_OVERLAY     = 0x98,
+	PSYQ_SET_OVERLAY = 0x9A
+};
+
+using PsyqRecordHeader = Record<Integer<4, true>, Integer<1>>;
+using PsyqName         = Record<PascalString>;
+
+// Layouts of the records that carry no symbols, indexed by record type. Every record
+// starts with its offset, so only line changes and function and block bounds carry
+// line numbers; "End SLD info" (0x8A) and "Set overlay" (0x9A) have no fields.
+static constexpr auto psyq_skip_records = []() {
+	std::array<void (*)(InputBuffer&), 0x100> skip_records = {};
+
+	skip_records[PSYQ_LINE_INC]    = &Record<>::Skip;
+	skip_records[PSYQ_LINE_ADD8]   = &Record<Bytes<1>>::Skip;
+	skip_records[PSYQ_LINE_ADD16]  = &Record<Bytes<2>>::Skip;
+	skip_records[PSYQ_LINE_SET]    = &Record<Bytes<4>>::Skip;
+	skip_records[PSYQ_LINE_FILE]   = &Record<Bytes<4>, PascalString>::Skip;
+	skip_records[PSYQ_LINE_END]    = &Record<>::Skip;
+	skip_records[PSYQ_FUNC_START]  = &Record<Bytes<20>, PascalString, PascalString>::Skip;
+	skip_records[PSYQ_FUNC_END]    = &Record<Bytes<4>>::Skip;
+	skip_records[PSYQ_BLOCK_START] = &Record<Bytes<4>>::Skip;
+	skip_records[PSYQ_BLOCK_END]   = &Record<Bytes<4>>::Skip;
+	skip_records[PSYQ_DEF]         = &Record<Bytes<8>, PascalString>::Skip;
+	skip_records[PSYQ_DEF_2]       = &Record<Bytes<8>, CountedBytes<Integer<2>, 4>, PascalString, PascalString>::Skip;
+	skip_records[PSYQ_OVERLAY]     = &Record<Bytes<8>>::Skip;
+	skip_records[PSYQ_SET_OVERLAY] = &Record<>::Skip;
+
+	return skip_records;
+}();
+
+bool Symbols::LoadPsyqSymbols(const std::string& file_name, InputBuffer& input)
+{
+	if (input.size < 8 || memcmp(input.data, "MND", 3) != 0 || input.data[3] != 1) {
+		return false;
+	}
+	SkipInput(input, 8);
+
+	while (input.offset < input.size) {
+		size_t record_offset = input.offset;
+		auto [value, type]   = PsyqRecordHeader::Read(input);
+
+		if (type == PSYQ_SYMBOL || type == PSYQ_LABEL) {
+			auto [name] = PsyqName::Read(input);
+			this->AddSymbol(name, value);
+		} else if (psyq_skip_records[type] != nullptr) {
+			psyq_skip_records[type](input);
+		} else {
+			throw std::runtime_error(("Unknown Psy-Q record type " + std::to_string(type) + " at offset " +
+			                          std::to_string(record_offset) + " in \"" + file_name + "\".").c_str());
+		}
+	}
+
+	return true;
+}
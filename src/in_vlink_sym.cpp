@@ -1,58 +1,73 @@
-/*
-	Copyright (c) 2025 Devon Artmeier
-
-	Permission to use, copy, modify, and /or distribute this software
-	for any purpose with or without fee is hereby granted.
-
-	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
-	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
-	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
-	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
-	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
-	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
-	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
-	PERFORMANCE OF THIS SOFTWARE.
-*/
-
-#include "shared.hpp"
-
-bool Symbols::LoadVlinkSymSymbols(const std::string& file_name)
-{
-	std::ifstream input(file_name, std::ios::in);
-	if (!input.is_open()) {
-		throw std::runtime_error(("Cannot open \"" + file_name + "\" for reading.").c_str());
-	}
-
-	std::string line;
-	while (std::getline(input, line)) {
-		if (!line.empty()) {
-			size_t colon = line.find(':');
-			if (colon == std::string::npos) {
-				return false;
-			}
-
-			std::string value_str = line.substr(0, colon);
-			std::string name      = line.substr(colon + 1);
-			if (value_str.empty() || name.empty()) {
-				return false;
-			}
-
-			long long value = 0;
-			try {
-				if (value_str.find("0x") != std::string::npos) {
-					value = std::stoull(value_str, nullptr, 16);
-				} else if (value_str.find("0b") != std::string::npos) {
-					value = std::stoull(value_str, nullptr, 2);
-				} else {
-					value = std::stoull(value_str, nullptr, 10);
-				}
-			} catch (...) {
-				return false;
-			}
-
-			this->AddSymbol(name, value);
-		}
-	}
-
-	return true;
-}
+/*
+	Copyright (c) 2025 Devon Artmeier
+
+	Permission to use, copy, modify, and /or distribute this software
+	for any purpose with or without fee is hereby granted.
+
+	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
+	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
+	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+	PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "shared.hpp"
+
+static bool ParseVlinkSymLine(const std::string& line, Symbol& symbol)
+{
+	size_t colon = line.find(':');
+	if (colon == std::string::npos) {
+		return false;
+	}
+
+	std::string value_str = line.substr(0, colon);
+	symbol.name           = line.substr(colon + 1);
+	if (value_str.empty() || symbol.name.empty()) {
+		return false;
+	}
+
+	try {
+		if (value_str.find("0x") != std::string::npos) {
+			symbol.value = std::stoull(value_str, nullptr, 16);
+		} else if (value_str.find("0b") != std::string::npos) {
+			symbol.value = std::stoull(value_str, nullptr, 2);
+		} else {
+			symbol.value = std::stoull(value_str, nullptr, 10);
+		}
+	} catch (...) {
+		return false;
+	}
+
+	return true;
+}
+
+bool Symbols::LoadVlinkSymSymbols(const std::string& file_name, InputBuffer& input)
+{
+	std::string line;
+	Symbol      symbol;
+	size_t      line_number = 0;
+
+	// The first symbol decides whether this is a vlink symbol file at all
+	while (ReadInputLine(input, line)) {
+		line_number++;
+		if (!line.empty()) {
+			if (!ParseVlinkSymLine(line, symbol)) {
+				return false;
+			}
+			this->AddSymbol(symbol.name, symbol.value);
+			break;
+		}
+	}
+
+	size_t error_line = ParseSymbolLines(input, line_number + 1, this->max_memory == 0, ParseVlinkSymLine, [&](const Symbol& symbol) {
+		this->AddSymbol(symbol.name, symbol.value);
+	});
+	if (error_line != 0) {
+		throw std::runtime_error(("Invalid symbol on line " + std::to_string(error_line) + " of \"" + file_name + "\".").c_str());
+	}
+
+	return true;
+}
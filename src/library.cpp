@@ -0,0 +1,342 @@
+/*
+	Copyright (c) 2025 Devon Artmeier
+
+	Permission to use, copy, modify, and /or distribute this software
+	for any purpose with or without fee is hereby granted.
+
+	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
+	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
+	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+	PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <sstream>
+
+#include "shared.hpp"
+#include "dumpasmsym.hpp"
+
+static void ApplyFilter(Symbols& symbols, const DumpFilter filter, const std::string& value)
+{
+	switch (filter) {
+		case DumpFilter::SymbolInclude:
+			symbols.AddSymbolInclude(value);
+			break;
+		case DumpFilter::SymbolExclude:
+			symbols.AddSymbolExclude(value);
+			break;
+		case DumpFilter::PrefixInclude:
+			symbols.AddPrefixInclude(value);
+			break;
+		case DumpFilter::PrefixExclude:
+			symbols.AddPrefixExclude(value);
+			break;
+		case DumpFilter::SuffixInclude:
+			symbols.AddSuffixInclude(value);
+			break;
+		case DumpFilter::SuffixExclude:
+			symbols.AddSuffixExclude(value);
+			break;
+		case DumpFilter::PrefixAdd:
+			symbols.SetPrefixAdd(value);
+			break;
+		case DumpFilter::SuffixAdd:
+			symbols.SetSuffixAdd(value);
+			break;
+		case DumpFilter::ValueOffset:
+			symbols.SetValueOffset(value);
+			break;
+		case DumpFilter::ArchiveMember:
+			symbols.AddArchiveMember(value);
+			break;
+	}
+}
+
+SymbolDumper::SymbolDumper()
+{
+	this->symbols = new Symbols();
+}
+
+SymbolDumper::~SymbolDumper()
+{
+	delete this->symbols;
+}
+
+DumpStatus SymbolDumper::Load(const std::string& input_name, const void* data, const size_t size)
+{
+	try {
+		if (!this->symbols->LoadSymbols(input_name, static_cast<const unsigned char*>(data), size)) {
+			return this->Fail(DumpStatus::InvalidFormat, "\"" + input_name + "\" is not a valid file.");
+		}
+	} catch (std::exception& e) {
+		return this->Fail(DumpStatus::Error, e.what());
+	}
+
+	this->dirty = true;
+	return DumpStatus::Ok;
+}
+
+DumpStatus SymbolDumper::AddFilter(const DumpFilter filter, const std::string& value)
+{
+	try {
+		ApplyFilter(*this->symbols, filter, value);
+	} catch (std::exception& e) {
+		return this->Fail(DumpStatus::Error, e.what());
+	}
+
+	this->dirty = true;
+	return DumpStatus::Ok;
+}
+
+DumpStatus SymbolDumper::GetSymbols(std::vector<DumpSymbol>& symbols_out)
+{
+	try {
+		this->UpdateSymbols();
+
+		symbols_out.clear();
+		this->symbols->ForEachOutputSymbol([&](const Symbol& symbol) {
+			symbols_out.push_back({ symbol.name, symbol.value });
+		});
+	} catch (std::exception& e) {
+		return this->Fail(DumpStatus::Error, e.what());
+	}
+
+	return DumpStatus::Ok;
+}
+
+DumpStatus SymbolDumper::Render(const DumpOutputOptions& options, void* buffer, const size_t capacity, size_t& size)
+{
+	std::string output_data;
+
+	try {
+		this->UpdateSymbols();
+
+		std::ostringstream output(std::ios::out | std::ios::binary);
+		this->symbols->Output(output, static_cast<ValueType>(options.value_type), static_cast<NumberBase>(options.number_base),
+		                      static_cast<OutputMode>(options.mode), static_cast<AsmDialect>(options.asm_dialect));
+		output_data = output.str();
+	} catch (std::exception& e) {
+		return this->Fail(DumpStatus::Error, e.what());
+	}
+
+	size = output_data.size();
+	if (size > capacity) {
+		return this->Fail(DumpStatus::BufferTooSmall, "Output buffer is too small.");
+	}
+	memcpy(buffer, output_data.data(), size);
+
+	return DumpStatus::Ok;
+}
+
+const std::string& SymbolDumper::GetError() const
+{
+	return this->error;
+}
+
+DumpStatus SymbolDumper::Fail(const DumpStatus status, const std::string& message)
+{
+	this->error = message;
+	return status;
+}
+
+void SymbolDumper::UpdateSymbols()
+{
+	if (this->dirty) {
+		this->symbols->GetOutputSymbols();
+		this->dirty = false;
+	}
+}
+
+struct SymbolReaderSlot
+{
+	std::atomic<unsigned long long> epoch  { 0 };
+	std::atomic<bool>               in_use { true };
+	SymbolReaderSlot*               next   { nullptr };
+};
+
+const DumpSymbol* SymbolSnapshot::FindValue(const long long value) const
+{
+	auto symbol = std::upper_bound(this->symbols.begin(), this->symbols.end(), value, [](const long long value, const DumpSymbol& symbol) {
+		return value < symbol.value;
+	});
+	if (symbol == this->symbols.begin()) {
+		return nullptr;
+	}
+
+	long long found_value = (--symbol)->value;
+	while (symbol != this->symbols.begin() && (symbol - 1)->value == found_value) {
+		symbol--;
+	}
+	return &*symbol;
+}
+
+const DumpSymbol* SymbolSnapshot::FindName(const std::string& name) const
+{
+	auto index = std::lower_bound(this->name_order.begin(), this->name_order.end(), name, [&](const size_t index, const std::string& name) {
+		return this->symbols[index].name < name;
+	});
+	if (index == this->name_order.end() || this->symbols[*index].name != name) {
+		return nullptr;
+	}
+	return &this->symbols[*index];
+}
+
+const std::vector<DumpSymbol>& SymbolSnapshot::GetSymbols() const
+{
+	return this->symbols;
+}
+
+SymbolReloader::~SymbolReloader()
+{
+	if (this->reload_thread.joinable()) {
+		this->reload_thread.join();
+	}
+	delete this->snapshot.load();
+
+	SymbolReaderSlot* slot = this->readers.load();
+	while (slot != nullptr) {
+		SymbolReaderSlot* next = slot->next;
+		delete slot;
+		slot = next;
+	}
+}
+
+DumpStatus SymbolReloader::AddFilter(const DumpFilter filter, const std::string& value)
+{
+	try {
+		Symbols symbols;
+		ApplyFilter(symbols, filter, value);
+	} catch (std::exception& e) {
+		std::lock_guard<std::mutex> lock(this->result_mutex);
+		this->error = e.what();
+		return DumpStatus::Error;
+	}
+
+	this->filters.push_back({ filter, value });
+	return DumpStatus::Ok;
+}
+
+DumpStatus SymbolReloader::Reload(const std::vector<std::string>& file_names)
+{
+	this->Wait();
+
+	this->reloading     = true;
+	this->reload_thread = std::thread(&SymbolReloader::BuildSnapshot, this, file_names, this->filters);
+	return DumpStatus::Ok;
+}
+
+bool SymbolReloader::IsReloading() const
+{
+	return this->reloading;
+}
+
+DumpStatus SymbolReloader::Wait()
+{
+	if (this->reload_thread.joinable()) {
+		this->reload_thread.join();
+	}
+
+	std::lock_guard<std::mutex> lock(this->result_mutex);
+	return this->status;
+}
+
+std::string SymbolReloader::GetError() const
+{
+	std::lock_guard<std::mutex> lock(this->result_mutex);
+	return this->error;
+}
+
+void SymbolReloader::BuildSnapshot(const std::vector<std::string> file_names, const std::vector<std::pair<DumpFilter, std::string>> filters)
+{
+	SymbolSnapshot* new_snapshot = new SymbolSnapshot();
+
+	try {
+		Symbols symbols;
+		for (const auto& filter : filters) {
+			ApplyFilter(symbols, filter.first, filter.second);
+		}
+		symbols.LoadSymbols(file_names);
+		symbols.GetOutputSymbols();
+
+		symbols.ForEachOutputSymbol([&](const Symbol& symbol) {
+			new_snapshot->symbols.push_back({ symbol.name, symbol.value });
+		});
+
+		new_snapshot->name_order.resize(new_snapshot->symbols.size());
+		for (size_t i = 0; i < new_snapshot->name_order.size(); i++) {
+			new_snapshot->name_order[i] = i;
+		}
+		std::sort(new_snapshot->name_order.begin(), new_snapshot->name_order.end(), [&](const size_t index_1, const size_t index_2) {
+			return new_snapshot->symbols[index_1].name < new_snapshot->symbols[index_2].name;
+		});
+	} catch (std::exception& e) {
+		delete new_snapshot;
+		{
+			std::lock_guard<std::mutex> lock(this->result_mutex);
+			this->status = DumpStatus::Error;
+			this->error  = e.what();
+		}
+		this->reloading = false;
+		return;
+	}
+
+	this->PublishSnapshot(new_snapshot);
+	{
+		std::lock_guard<std::mutex> lock(this->result_mutex);
+		this->status = DumpStatus::Ok;
+		this->error  = "";
+	}
+	this->reloading = false;
+}
+
+void SymbolReloader::PublishSnapshot(SymbolSnapshot* new_snapshot)
+{
+	SymbolSnapshot*    old_snapshot = this->snapshot.exchange(new_snapshot);
+	unsigned long long new_epoch    = ++this->epoch;
+
+	// Readers that entered before the swap may still hold the old snapshot, wait for them to move on
+	for (SymbolReaderSlot* slot = this->readers.load(); slot != nullptr; slot = slot->next) {
+		unsigned long long reader_epoch;
+		while ((reader_epoch = slot->epoch.load()) != 0 && reader_epoch < new_epoch) {
+			std::this_thread::yield();
+		}
+	}
+
+	delete old_snapshot;
+}
+
+SymbolReader::SymbolReader(SymbolReloader& reloader) : reloader(reloader)
+{
+	for (SymbolReaderSlot* slot = reloader.readers.load(); slot != nullptr; slot = slot->next) {
+		bool in_use = false;
+		if (slot->in_use.compare_exchange_strong(in_use, true)) {
+			this->slot = slot;
+			return;
+		}
+	}
+
+	this->slot       = new SymbolReaderSlot();
+	this->slot->next = reloader.readers.load();
+	while (!reloader.readers.compare_exchange_weak(this->slot->next, this->slot)) {
+	}
+}
+
+SymbolReader::~SymbolReader()
+{
+	this->slot->epoch  = 0;
+	this->slot->in_use = false;
+}
+
+const SymbolSnapshot* SymbolReader::Acquire()
+{
+	this->slot->epoch = this->reloader.epoch.load();
+	return this->reloader.snapshot.load();
+}
+
+void SymbolReader::Release()
+{
+	this->slot->epoch = 0;
+}
@@ -1,192 +1,356 @@
-/*
-	Copyright (c) 2025 Devon Artmeier
-
-	Permission to use, copy, modify, and /or distribute this software
-	for any purpose with or without fee is hereby granted.
-
-	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
-	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
-	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
-	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
-	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
-	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
-	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
-	PERFORMANCE OF THIS SOFTWARE.
-*/
-
-#include "shared.hpp"
-
-int main(int argc, char* argv[])
-{
-	if (argc < 2) {
-		std::cout << "Usage: dumpasmsym -o [output] <-m [mode]> <-v [type]> <-b [base]> <-f [offset]> <-iy [symbol]>" << std::endl <<
-		             "                  <-xy [symbol]> <-ip [prefix]> <-xp [prefix]> <-ap [prefix]> <-is [suffix]>" << std::endl <<
-		             "                  <-xs [suffix]> <-as [suffix]> [input files]" << std::endl << std::endl <<
-		             "           -o [output]     - Output file" << std::endl <<
-		             "           <-m [mode]>     - Output mode" << std::endl <<
-		             "                             bin - Binary (default)" << std::endl <<
-		             "                             asm - Assembly" << std::endl <<
-		             "                             c   - C" << std::endl <<
-		             "           <-v [type]>     - Value type (TEXT OUTPUT MODE ONLY)" << std::endl <<
-		             "                             u32 - Unsigned 32-bit (default)" << std::endl <<
-		             "                             u64 - Unsigned 64-bit" << std::endl <<
-		             "                             s32 - Signed 32-bit" << std::endl <<
-		             "                             s64 - Signed 64-bit" << std::endl <<
-		             "           <-b [base]>     - Numerical system (TEXT OUTPUT MODE ONLY)" << std::endl <<
-		             "                             hex - Hexadecimal (default)" << std::endl <<
-		             "                             dec - Decimal" << std::endl <<
-		             "                             bin - Binary" << std::endl <<
-		             "           <-f [offset]>   - Add offset to symbol values" << std::endl <<
-		             "                             Labels can be added in text output mode" << std::endl <<
-		             "           <-iy [symbol]>  - Only include symbol" << std::endl <<
-		             "           <-xy [symbol]>  - Exclude symbol" << std::endl <<
-		             "           <-ip [prefix]>  - Only include symbols with prefix" << std::endl <<
-		             "           <-xp [prefix]>  - Exclude symbols with prefix" << std::endl <<
-		             "           <-ap [prefix]>  - Add prefix to symbol names" << std::endl <<
-		             "           <-is [suffix]>  - Only include symbols with suffix" << std::endl <<
-		             "           <-xs [suffix]>  - Exclude symbols with suffix" << std::endl <<
-		             "           <-as [suffix]>  - Add suffix to symbol names" << std::endl <<
-		             "           [input files]   - List of input files" << std::endl << std::endl <<
-		             "Valid input file formats:" << std::endl << std::endl <<
-		             "           Binary file generated from this tool" << std::endl <<
-		             "           Psy-Q symbol file" << std::endl <<
-		             "           vasm vobj file" << std::endl <<
-		             "           vasm vlink symbol file (default format only)" << std::endl << std::endl;
-		return -1;
-	}
-
-	Symbols                  symbols;
-	std::vector<std::string> input_files;
-	std::string              output_file = "";
-	OutputMode               output_mode = OutputMode::Binary;
-	ValueType                value_type  = ValueType::Unsigned32;
-	NumberBase               number_base = NumberBase::Hex;
-
-	try {
-		for (int i = 1; i < argc; i++) {
-			if (CheckArgument(argc, argv, i, "o")) {
-				if (!output_file.empty()) {
-					throw std::runtime_error("Output file already defined.");
-				}
-
-				output_file = argv[i];
-				continue;
-			}
-
-			if (CheckArgument(argc, argv, i, "m")) {
-				std::string mode = StringToLower(argv[i]);
-
-				if (mode.compare("bin") == 0) {
-					output_mode = OutputMode::Binary;
-				} else if (mode.compare("asm") == 0) {
-					output_mode = OutputMode::Asm;
-				} else if (mode.compare("c") == 0) {
-					output_mode = OutputMode::C;
-				} else {
-					throw std::runtime_error(("Invalid output mode \"" + (std::string)argv[i] + "\"").c_str());
-				}
-
-				continue;
-			}
-
-			if (CheckArgument(argc, argv, i, "v")) {
-				std::string type = StringToLower(argv[i]);
-
-				if (type.compare("u32") == 0) {
-					value_type = ValueType::Unsigned32;
-				} else if (type.compare("u64") == 0) {
-					value_type = ValueType::Unsigned64;
-				} else if (type.compare("s32") == 0) {
-					value_type = ValueType::Signed32;
-				} else if (type.compare("s64") == 0) {
-					value_type = ValueType::Signed64;
-				} else {
-					throw std::runtime_error(("Invalid value type \"" + (std::string)argv[i] + "\"").c_str());
-				}
-
-				continue;
-			}
-
-			if (CheckArgument(argc, argv, i, "b")) {
-				std::string type = StringToLower(argv[i]);
-
-				if (type.compare("hex") == 0) {
-					number_base = NumberBase::Hex;
-				} else if (type.compare("dec") == 0) {
-					number_base = NumberBase::Decimal;
-				} else if (type.compare("bin") == 0) {
-					number_base = NumberBase::Binary;
-				} else {
-					throw std::runtime_error(("Invalid numerical system \"" + (std::string)argv[i] + "\"").c_str());
-				}
-
-				continue;
-			}
-
-			if (CheckArgument(argc, argv, i, "f")) {
-				symbols.SetValueOffset(argv[i]);
-				continue;
-			}
-
-			if (CheckArgument(argc, argv, i, "iy")) {
-				symbols.AddSymbolInclude(argv[i]);
-				continue;
-			}
-
-			if (CheckArgument(argc, argv, i, "xy")) {
-				symbols.AddSymbolExclude(argv[i]);
-				continue;
-			}
-
-			if (CheckArgument(argc, argv, i, "ip")) {
-				symbols.AddPrefixInclude(argv[i]);
-				continue;
-			}
-
-			if (CheckArgument(argc, argv, i, "xp")) {
-				symbols.AddPrefixExclude(argv[i]);
-				continue;
-			}
-
-			if (CheckArgument(argc, argv, i, "ap")) {
-				symbols.SetPrefixAdd(argv[i]);
-				continue;
-			}
-
-			if (CheckArgument(argc, argv, i, "is")) {
-				symbols.AddSuffixInclude(argv[i]);
-				continue;
-			}
-
-			if (CheckArgument(argc, argv, i, "xs")) {
-				symbols.AddSuffixExclude(argv[i]);
-				continue;
-			}
-
-			if (CheckArgument(argc, argv, i, "as")) {
-				symbols.SetSuffixAdd(argv[i]);
-				continue;
-			}
-
-			input_files.push_back(argv[i]);
-		}
-
-		if (input_files.empty()) {
-			throw std::runtime_error("Input symbol files not defined.");
-		}
-		if (output_file.empty()) {
-			throw std::runtime_error("Output symbol file not defined.");
-		}
-
-		for (const auto& input_file : input_files) {
-			symbols.LoadSymbols(input_file);
-		}
-		symbols.GetOutputSymbols();
-		symbols.Output(output_file, value_type, number_base, output_mode);
-	} catch (std::exception& e) {
-		std::cout << "Error: " << e.what() << std::endl;
-		return -1;
-	}
-
-	return 0;
-}
+/*
+	Copyright (c) 2025 Devon Artmeier
+
+	Permission to use, copy, modify, and /or distribute this software
+	for any purpose with or without fee is hereby granted.
+
+	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
+	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
+	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+	PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "shared.hpp"
+#include "alloc_tracker.hpp"
+
+struct Option
+{
+	bool                                    has_parameter;
+	std::function<void(const std::string&)> handler;
+};
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2) {
+		std::cout << "Usage: dumpasmsym -o [output] <-m [mode]> <-v [type]> <-b [base]> <-d [dialect]> <-f [offset]>" << std::endl <<
+		             "                  <-iy [symbol]> <-xy [symbol]> <-ip [prefix]> <-xp [prefix]> <-ap [prefix]>" << std::endl <<
+		             "                  <-is [suffix]> <-xs [suffix]> <-as [suffix]> <--max-memory [size]> <--watch>" << std::endl <<
+		             "                  <--include-list [file]> <--exclude-list [file]> <-r [range]> <--remap-file [file]>" << std::endl <<
+		             "                  <--unmapped [mode]> <--shard [shard]> <--shard-file [file]> <--member [name]>" << std::endl <<
+		             "                  <--stream> <--append-to [file]> <--history [file]> <--build-name [name]>" << std::endl <<
+		             "                  <--history-symbol [symbol]> <--history-address [address]> <--history-build [build]>" << std::endl <<
+		             "                  [input files]" << std::endl << std::endl <<
+		             "           -o [output]     - Output file (\"-\" for standard output)" << std::endl <<
+		             "           <--append-to [file]>" << std::endl <<
+		             "                           - Merge the symbols into an existing binary file instead of" << std::endl <<
+		             "                             writing an output file (created if missing)" << std::endl <<
+		             "           <--history [file]>" << std::endl <<
+		             "                           - Add the symbols to a history file as a new build (created if" << std::endl <<
+		             "                             missing), or query it when no input files are given" << std::endl <<
+		             "           <--build-name [name]>" << std::endl <<
+		             "                           - Name of the build added to the history file (input file names" << std::endl <<
+		             "                             by default)" << std::endl <<
+		             "           <--history-symbol [symbol]>" << std::endl <<
+		             "                           - Print every value a symbol had in the history file" << std::endl <<
+		             "           <--history-address [address]>" << std::endl <<
+		             "                           - Print the symbols at or nearest below an address (hexadecimal)" << std::endl <<
+		             "           <--history-build [build]>" << std::endl <<
+		             "                           - Build to look up addresses in (number or name, latest by default)" << std::endl <<
+		             "           <-m [mode]>     - Output mode" << std::endl <<
+		             "                             bin     - Binary (default)" << std::endl <<
+		             "                             asm     - Assembly" << std::endl <<
+		             "                             c       - C" << std::endl <<
+		             "                             asmhash - Assembly name lookup table (perfect hash)" << std::endl <<
+		             "                             chash   - C name lookup table and function (perfect hash)" << std::endl <<
+		             "           <-v [type]>     - Value type (TEXT OUTPUT MODE ONLY)" << std::endl <<
+		             "                             u32 - Unsigned 32-bit (default)" << std::endl <<
+		             "                             u64 - Unsigned 64-bit" << std::endl <<
+		             "                             s32 - Signed 32-bit" << std::endl <<
+		             "                             s64 - Signed 64-bit" << std::endl <<
+		             "           <-b [base]>     - Numerical system (TEXT OUTPUT MODE ONLY)" << std::endl <<
+		             "                             hex - Hexadecimal (default)" << std::endl <<
+		             "                             dec - Decimal" << std::endl <<
+		             "                             bin - Binary" << std::endl <<
+		             "           <-d [dialect]>  - Assembler dialect (ASSEMBLY OUTPUT MODE ONLY)" << std::endl <<
+		             "                             asm68k - asm68k (default)" << std::endl <<
+		             "                             vasm   - vasm (Motorola syntax)" << std::endl <<
+		             "                             ca65   - ca65" << std::endl <<
+		             "                             nasm   - NASM" << std::endl <<
+		             "                             gas    - GNU as" << std::endl <<
+		             "           <-f [offset]>   - Add offset to symbol values" << std::endl <<
+		             "                             Labels can be added in text output mode" << std::endl <<
+		             "           <-iy [symbol]>  - Only include symbol" << std::endl <<
+		             "           <-xy [symbol]>  - Exclude symbol" << std::endl <<
+		             "           <--include-list [file]>" << std::endl <<
+		             "                           - Only include symbols listed in file (one per line)" << std::endl <<
+		             "           <--exclude-list [file]>" << std::endl <<
+		             "                           - Exclude symbols listed in file (one per line)" << std::endl <<
+		             "           <-ip [prefix]>  - Only include symbols with prefix" << std::endl <<
+		             "           <-xp [prefix]>  - Exclude symbols with prefix" << std::endl <<
+		             "           <-ap [prefix]>  - Add prefix to symbol names" << std::endl <<
+		             "           <-is [suffix]>  - Only include symbols with suffix" << std::endl <<
+		             "           <-xs [suffix]>  - Exclude symbols with suffix" << std::endl <<
+		             "           <-as [suffix]>  - Add suffix to symbol names" << std::endl <<
+		             "           <--max-memory [size]>" << std::endl <<
+		             "                           - Limit memory used for symbols, spilling sorted runs" << std::endl <<
+		             "                             to temporary files (K, M and G suffixes allowed)" << std::endl <<
+		             "           <-r [range]>    - Remap symbol values in range (\"start-end=target\", hexadecimal," << std::endl <<
+		             "                             end inclusive)" << std::endl <<
+		             "           <--remap-file [file]>" << std::endl <<
+		             "                           - Read remap ranges from file (one per line)" << std::endl <<
+		             "           <--unmapped [mode]>" << std::endl <<
+		             "                           - Handling of symbols outside of every remap range" << std::endl <<
+		             "                             keep  - Leave value unchanged and warn (default)" << std::endl <<
+		             "                             drop  - Remove symbol" << std::endl <<
+		             "                             error - Stop with an error" << std::endl <<
+		             "           <--shard [shard]>" << std::endl <<
+		             "                           - Also write the symbols in an address range or with a prefix" << std::endl <<
+		             "                             to a separate file (\"file=start-end\" or \"file=prefix*\")" << std::endl <<
+		             "                             Output file is optional when shards are defined" << std::endl <<
+		             "           <--shard-file [file]>" << std::endl <<
+		             "                           - Read shards from file (one per line)" << std::endl <<
+		             "           <--member [name]>" << std::endl <<
+		             "                           - Only read this member from archives (\"name*\" matches a prefix)" << std::endl <<
+		             "           <--stream>      - Write a single sorted input straight through without building" << std::endl <<
+		             "                             the symbol table (unsorted inputs are loaded normally)" << std::endl <<
+		             "           <--watch>       - Keep running and update the output when input files change" << std::endl <<
+		             "           [input files]   - List of input files (\"-\" for standard input)" << std::endl << std::endl <<
+		             "Arguments can also be read from a response file with \"@[file]\"." << std::endl << std::endl <<
+		             "Valid input file formats:" << std::endl << std::endl <<
+		             "           Binary file generated from this tool" << std::endl <<
+		             "           Psy-Q symbol file" << std::endl <<
+		             "           vasm vobj file" << std::endl <<
+		             "           ar archive of vasm vobj files" << std::endl <<
+		             "           vasm vlink symbol file (default format only)" << std::endl <<
+		             "           vlink or GNU ld linker map file" << std::endl << std::endl;
+		return -1;
+	}
+
+	Symbols                  symbols;
+	std::vector<std::string> arguments;
+	std::vector<std::string> input_files;
+	std::string              output_file   = "";
+	std::string              append_file   = "";
+	std::string              history_file  = "";
+	std::string              build_name    = "";
+	std::string              history_build = "";
+	std::vector<std::string> history_symbols;
+	std::vector<long long>   history_addresses;
+	OutputMode               output_mode   = OutputMode::Binary;
+	ValueType                value_type    = ValueType::Unsigned32;
+	NumberBase               number_base   = NumberBase::Hex;
+	AsmDialect               asm_dialect   = AsmDialect::Asm68k;
+	bool                     watch         = false;
+
+	const std::unordered_map<std::string, Option> options = {
+		{ "-o", { true, [&](const std::string& parameter) {
+			if (!output_file.empty()) {
+				throw std::runtime_error("Output file already defined.");
+			}
+			output_file = parameter;
+			symbols.SetOutputFile(parameter);
+		} } },
+
+		{ "--append-to", { true, [&](const std::string& parameter) {
+			if (!append_file.empty()) {
+				throw std::runtime_error("Append file already defined.");
+			}
+			append_file = parameter;
+		} } },
+
+		{ "--history", { true, [&](const std::string& parameter) {
+			if (!history_file.empty()) {
+				throw std::runtime_error("History file already defined.");
+			}
+			history_file = parameter;
+		} } },
+
+		{ "--history-symbol", { true, [&](const std::string& parameter) {
+			history_symbols.push_back(parameter);
+		} } },
+
+		{ "--history-address", { true, [&](const std::string& parameter) {
+			long long address;
+			if (!ParseHexValue(parameter, address)) {
+				throw std::runtime_error(("Invalid address \"" + parameter + "\"").c_str());
+			}
+			history_addresses.push_back(address);
+		} } },
+
+		{ "--history-build", { true, [&](const std::string& parameter) {
+			if (!history_build.empty()) {
+				throw std::runtime_error("History build already defined.");
+			}
+			history_build = parameter;
+		} } },
+
+		{ "-m", { true, [&](const std::string& parameter) {
+			std::string mode = StringToLower(parameter);
+
+			if (mode.compare("bin") == 0) {
+				output_mode = OutputMode::Binary;
+			} else if (mode.compare("asm") == 0) {
+				output_mode = OutputMode::Asm;
+			} else if (mode.compare("c") == 0) {
+				output_mode = OutputMode::C;
+			} else if (mode.compare("asmhash") == 0) {
+				output_mode = OutputMode::AsmHash;
+			} else if (mode.compare("chash") == 0) {
+				output_mode = OutputMode::CHash;
+			} else {
+				throw std::runtime_error(("Invalid output mode \"" + parameter + "\"").c_str());
+			}
+		} } },
+
+		{ "-v", { true, [&](const std::string& parameter) {
+			std::string type = StringToLower(parameter);
+
+			if (type.compare("u32") == 0) {
+				value_type = ValueType::Unsigned32;
+			} else if (type.compare("u64") == 0) {
+				value_type = ValueType::Unsigned64;
+			} else if (type.compare("s32") == 0) {
+				value_type = ValueType::Signed32;
+			} else if (type.compare("s64") == 0) {
+				value_type = ValueType::Signed64;
+			} else {
+				throw std::runtime_error(("Invalid value type \"" + parameter + "\"").c_str());
+			}
+		} } },
+
+		{ "-b", { true, [&](const std::string& parameter) {
+			std::string type = StringToLower(parameter);
+
+			if (type.compare("hex") == 0) {
+				number_base = NumberBase::Hex;
+			} else if (type.compare("dec") == 0) {
+				number_base = NumberBase::Decimal;
+			} else if (type.compare("bin") == 0) {
+				number_base = NumberBase::Binary;
+			} else {
+				throw std::runtime_error(("Invalid numerical system \"" + parameter + "\"").c_str());
+			}
+		} } },
+
+		{ "-d", { true, [&](const std::string& parameter) {
+			std::string dialect = StringToLower(parameter);
+
+			if (dialect.compare("asm68k") == 0) {
+				asm_dialect = AsmDialect::Asm68k;
+			} else if (dialect.compare("vasm") == 0) {
+				asm_dialect = AsmDialect::Vasm;
+			} else if (dialect.compare("ca65") == 0) {
+				asm_dialect = AsmDialect::Ca65;
+			} else if (dialect.compare("nasm") == 0) {
+				asm_dialect = AsmDialect::Nasm;
+			} else if (dialect.compare("gas") == 0) {
+				asm_dialect = AsmDialect::Gas;
+			} else {
+				throw std::runtime_error(("Invalid assembler dialect \"" + parameter + "\"").c_str());
+			}
+		} } },
+
+		{ "-f",             { true,  [&](const std::string& parameter) { symbols.SetValueOffset(parameter); } } },
+		{ "--max-memory",   { true,  [&](const std::string& parameter) { symbols.SetMaxMemory(parameter); } } },
+		{ "--watch",        { false, [&](const std::string&)           { symbols.SetWatch(); watch = true; } } },
+		{ "-iy",            { true,  [&](const std::string& parameter) { symbols.AddSymbolInclude(parameter); } } },
+		{ "-xy",            { true,  [&](const std::string& parameter) { symbols.AddSymbolExclude(parameter); } } },
+		{ "--include-list", { true,  [&](const std::string& parameter) { symbols.AddSymbolIncludeList(parameter); } } },
+		{ "--exclude-list", { true,  [&](const std::string& parameter) { symbols.AddSymbolExcludeList(parameter); } } },
+		{ "-ip",            { true,  [&](const std::string& parameter) { symbols.AddPrefixInclude(parameter); } } },
+		{ "-xp",            { true,  [&](const std::string& parameter) { symbols.AddPrefixExclude(parameter); } } },
+		{ "-ap",            { true,  [&](const std::string& parameter) { symbols.SetPrefixAdd(parameter); } } },
+		{ "-is",            { true,  [&](const std::string& parameter) { symbols.AddSuffixInclude(parameter); } } },
+		{ "-xs",            { true,  [&](const std::string& parameter) { symbols.AddSuffixExclude(parameter); } } },
+		{ "-as",            { true,  [&](const std::string& parameter) { symbols.SetSuffixAdd(parameter); } } },
+		{ "-r",             { true,  [&](const std::string& parameter) { symbols.AddRemapRange(parameter); } } },
+		{ "--remap-file",   { true,  [&](const std::string& parameter) { symbols.AddRemapFile(parameter); } } },
+		{ "--unmapped",     { true,  [&](const std::string& parameter) { symbols.SetUnmappedMode(parameter); } } },
+		{ "--shard",        { true,  [&](const std::string& parameter) { symbols.AddShard(parameter); } } },
+		{ "--shard-file",   { true,  [&](const std::string& parameter) { symbols.AddShardFile(parameter); } } },
+		{ "--member",       { true,  [&](const std::string& parameter) { symbols.AddArchiveMember(parameter); } } },
+		{ "--stream",       { false, [&](const std::string&)           { symbols.SetStream(); } } },
+		{ "--build-name",   { true,  [&](const std::string& parameter) { build_name = parameter; } } }
+	};
+
+	try {
+		BeginAllocationPhase("arguments");
+		ReadArguments(argc, argv, arguments);
+
+		for (size_t i = 0; i < arguments.size(); i++) {
+			auto option = options.find(arguments[i]);
+			if (option == options.end()) {
+				input_files.push_back(arguments[i]);
+				continue;
+			}
+
+			std::string parameter = "";
+			if (option->second.has_parameter) {
+				if (++i >= arguments.size()) {
+					throw std::runtime_error(("Missing parameter for \"" + option->first + "\"").c_str());
+				}
+				parameter = arguments[i];
+			}
+			option->second.handler(parameter);
+		}
+
+		if (!history_symbols.empty() || !history_addresses.empty()) {
+			if (history_file.empty()) {
+				throw std::runtime_error("History file not defined.");
+			}
+			if (!input_files.empty()) {
+				throw std::runtime_error("History queries cannot be combined with input files.");
+			}
+
+			SymbolHistory history;
+			history.Open(history_file);
+			for (const auto& history_symbol : history_symbols) {
+				history.WriteNameHistory(std::cout, history_symbol);
+			}
+			for (const auto& history_address : history_addresses) {
+				history.WriteAddressSymbols(std::cout, history.FindBuild(history_build), history_address);
+			}
+
+			ReportAllocations();
+			return 0;
+		}
+
+		if (input_files.empty()) {
+			throw std::runtime_error("Input symbol files not defined.");
+		}
+		if (output_file.empty() && append_file.empty() && history_file.empty() && !symbols.HasShards()) {
+			throw std::runtime_error("Output symbol file not defined.");
+		}
+		if (!append_file.empty() && (!output_file.empty() || output_mode != OutputMode::Binary || watch)) {
+			throw std::runtime_error("Appending cannot be combined with an output file, a text output mode or watch mode.");
+		}
+		if (!history_file.empty() && watch) {
+			throw std::runtime_error("History files cannot be combined with watch mode.");
+		}
+		if (std::count(input_files.begin(), input_files.end(), "-") > 1) {
+			throw std::runtime_error("Standard input can only be read once.");
+		}
+		if (watch && (output_file.compare("-") == 0 || std::count(input_files.begin(), input_files.end(), "-") > 0)) {
+			throw std::runtime_error("Watch mode cannot be used with standard input or output.");
+		}
+
+		BeginAllocationPhase("load");
+		symbols.LoadSymbols(input_files);
+		BeginAllocationPhase("sort");
+		symbols.GetOutputSymbols();
+		BeginAllocationPhase("output");
+		if (!append_file.empty()) {
+			symbols.AppendBinary(append_file);
+		}
+		if (!history_file.empty()) {
+			symbols.AppendHistory(history_file, build_name);
+		}
+		symbols.WriteOutputs(output_file, value_type, number_base, output_mode, asm_dialect);
+
+		if (watch) {
+			BeginAllocationPhase("watch");
+			symbols.Watch(output_file, value_type, number_base, output_mode, asm_dialect);
+		}
+	} catch (std::exception& e) {
+		std::cerr << "Error: " << e.what() << std::endl;
+		ReportAllocations();
+		return -1;
+	}
+
+	ReportAllocations();
+	return 0;
+}
@@ -1,51 +1,38 @@
-/*
-	Copyright (c) 2025 Devon Artmeier
-
-	Permission to use, copy, modify, and /or distribute this software
-	for any purpose with or without fee is hereby granted.
-
-	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
-	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
-	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
-	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
-	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
-	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
-	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
-	PERFORMANCE OF THIS SOFTWARE.
-*/
-
-#include "shared.hpp"
-
-void Symbols::OutputAsm(const std::string& file_name, const ValueType value_type, const NumberBase number_base)
-{
-	std::ofstream output(file_name, std::ios::out);
-	if (!output.is_open()) {
-		throw std::runtime_error(("Cannot open \"" + file_name + "\" for writing.").c_str());
-	}
-
-	if (input_file_names.empty()) {
-		output << "; ------------------------------------------------------------------------------" << std::endl <<
-		          "; No valid symbol files found" << std::endl;
-		output << "; ------------------------------------------------------------------------------";
-	} else {
-		int line_length = GetLineLength();
-
-		output << "; ------------------------------------------------------------------------------" << std::endl <<
-				  "; Symbols extracted from" << std::endl;
-		for (const auto& input_file_name : input_file_names) {
-			output << "; " << input_file_name << std::endl;
-		}
-		output << "; ------------------------------------------------------------------------------" << std::endl << std::endl;
-
-		for (auto& symbol : this->symbols_out) {
-			output << std::left << std::setw(line_length) << symbol.name << "equ ";
-			WriteOutputValue(output, symbol.value, "$", "%", value_type, number_base);
-			if (!this->value_offset.empty()) {
-				output << "+" << this->value_offset;
-			}
-			output << std::endl;
-		}
-
-		output << std::endl << "; ------------------------------------------------------------------------------";
-	}
-}
+/*
+	Copyright (c) 2025 Devon Artmeier
+
+	Permission to use, copy, modify, and /or distribute this software
+	for any purpose with or without fee is hereby granted.
+
+	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
+	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
+	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+	PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "shared.hpp"
+
+void Symbols::OutputAsm(std::ostream& output, const ValueType value_type, const NumberBase number_base, const AsmDialect asm_dialect)
+{
+	switch (asm_dialect) {
+		case AsmDialect::Asm68k:
+			this->OutputText<Asm68kDialect>(output, value_type, number_base);
+			break;
+		case AsmDialect::Vasm:
+			this->OutputText<VasmDialect>(output, value_type, number_base);
+			break;
+		case AsmDialect::Ca65:
+			this->OutputText<Ca65Dialect>(output, value_type, number_base);
+			break;
+		case AsmDialect::Nasm:
+			this->OutputText<NasmDialect>(output, value_type, number_base);
+			break;
+		case AsmDialect::Gas:
+			this->OutputText<GasDialect>(output, value_type, number_base);
+			break;
+	}
+}
@@ -1,66 +1,180 @@
-/*
-	Copyright (c) 2025 Devon Artmeier
-
-	Permission to use, copy, modify, and /or distribute this software
-	for any purpose with or without fee is hereby granted.
-
-	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
-	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
-	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
-	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
-	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
-	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
-	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
-	PERFORMANCE OF THIS SOFTWARE.
-*/
-
-#include "shared.hpp"
-
-static void StoreNumber(std::ofstream& output, const long long number, const int bytes)
-{
-	char* write_buffer = new char[bytes];
-
-	for (int i = 0; i < bytes; i++) {
-		write_buffer[i] = (number >> (i * 8)) & 0xFF;
-	}
-	output.write(write_buffer, bytes);
-
-	delete[] write_buffer;
-}
-
-static void StoreString(std::ofstream& output, const std::string& string)
-{
-	char size = string.size();
-
-	output.write(&size, 1);
-	output.write(string.c_str(), size);
-}
-
-void Symbols::OutputBinary(const std::string& file_name, const ValueType value_type, const NumberBase number_base)
-{
-	std::ofstream output(file_name, std::ios::out | std::ios::binary);
-	if (!output.is_open()) {
-		throw std::runtime_error(("Cannot open \"" + file_name + "\" for writing.").c_str());
-	}
-
-	long long value_offset_int = 0;
-	try {
-		value_offset_int = std::stoll(this->value_offset, nullptr, 16);
-	} catch (...) {
-		throw std::runtime_error(("Invalid value offset \"" + this->value_offset + "\".").c_str());
-	}
-
-	const char* signature = "BSYM";
-	output.write(signature, 4);
-
-	StoreNumber(output, this->symbols_out.size(), 4);
-	for (auto& symbol : this->symbols_out) {
-		StoreString(output, symbol.name);
-		StoreNumber(output, symbol.value + value_offset_int, 8);
-	}
-
-	StoreNumber(output, this->input_file_names.size(), 4);
-	for (const auto& input_file_name : this->input_file_names) {
-		StoreString(output, input_file_name);
-	}
-}
+/*
+	Copyright (c) 2025 Devon Artmeier
+
+	Permission to use, copy, modify, and /or distribute this software
+	for any purpose with or without fee is hereby granted.
+
+	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
+	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
+	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+	PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "shared.hpp"
+
+static void StoreNumber(std::ostream& output, const long long number, const int bytes)
+{
+	char write_buffer[8];
+
+	for (int i = 0; i < bytes; i++) {
+		write_buffer[i] = (number >> (i * 8)) & 0xFF;
+	}
+	output.write(write_buffer, bytes);
+}
+
+static void StoreString(std::ostream& output, const std::string& string)
+{
+	char size = string.size();
+
+	output.write(&size, 1);
+	output.write(string.c_str(), size);
+}
+
+static bool CompareSymbols(const Symbol& symbol_1, const Symbol& symbol_2)
+{
+	return symbol_1.value < symbol_2.value || (symbol_1.value == symbol_2.value && symbol_1.name < symbol_2.name);
+}
+
+void Symbols::OutputBinary(std::ostream& output, const ValueType value_type, const NumberBase number_base)
+{
+	long long value_offset_int = ParseValueOffset(this->value_offset);
+
+	const char* signature = "BSYM";
+	output.write(signature, 4);
+
+	StoreNumber(output, this->GetOutputCount(), 4);
+	this->ForEachOutputSymbol([&](const Symbol& symbol) {
+		StoreString(output, symbol.name);
+		StoreNumber(output, symbol.value + value_offset_int, 8);
+	});
+
+	StoreNumber(output, this->input_file_names.size(), 4);
+	for (const auto& input_file_name : this->input_file_names) {
+		StoreString(output, input_file_name);
+	}
+}
+
+void Symbols::AppendBinary(const std::string& file_name)
+{
+	long long value_offset_int = ParseValueOffset(this->value_offset);
+
+	// Existing symbols are only checked against the new ones, which are the only symbols held in memory
+	std::unordered_map<std::string, long long> new_values;
+	this->ForEachOutputSymbol([&](const Symbol& symbol) {
+		new_values.emplace(symbol.name, symbol.value + value_offset_int);
+	});
+
+	std::vector<unsigned char> buffer;
+	InputBuffer                master = { nullptr, 0, 0 };
+	bool                       exists = FileExists(file_name);
+
+#ifndef _WIN32
+	MappedFile mapped_file;
+	if (exists && mapped_file.Open(file_name)) {
+		master = { mapped_file.GetData(), mapped_file.GetSize(), 0 };
+	} else
+#endif
+	if (exists) {
+		ReadFile(file_name, buffer);
+		master = { buffer.data(), buffer.size(), 0 };
+	}
+
+	long long master_count = 0;
+	if (exists) {
+		if (master.size < 4 || memcmp(master.data, "BSYM", 4) != 0) {
+			throw std::runtime_error(("\"" + file_name + "\" is not a valid binary symbol file.").c_str());
+		}
+		std::tie(master_count) = BsymHeader::Read(master);
+	}
+
+	std::string   temp_file_name = CreateTempFile(file_name);
+	std::ofstream output(temp_file_name, std::ios::out | std::ios::binary);
+	if (!output.is_open()) {
+		std::remove(temp_file_name.c_str());
+		throw std::runtime_error(("Cannot open \"" + temp_file_name + "\" for writing.").c_str());
+	}
+
+	try {
+		Symbol master_symbol;
+		bool   have_master  = false;
+		size_t output_count = 0;
+
+		auto next_master_symbol = [&]() {
+			while (master_count > 0) {
+				master_count--;
+				std::tie(master_symbol.name, master_symbol.value) = BsymSymbol::Read(master);
+
+				auto new_value = new_values.find(master_symbol.name);
+				if (new_value == new_values.end()) {
+					have_master = true;
+					return;
+				}
+				if (new_value->second != master_symbol.value) {
+					throw std::runtime_error(("Multiple definitions of symbol \"" + master_symbol.name + "\" detected.").c_str());
+				}
+			}
+			have_master = false;
+		};
+
+		auto write_symbol = [&](const Symbol& symbol) {
+			StoreString(output, symbol.name);
+			StoreNumber(output, symbol.value, 8);
+			output_count++;
+		};
+
+		output.write("BSYM", 4);
+		StoreNumber(output, 0, 4);
+
+		// Both sides are in value order, so a single merge pass keeps the result sorted
+		next_master_symbol();
+		this->ForEachOutputSymbol([&](const Symbol& symbol) {
+			Symbol new_symbol = { symbol.name, symbol.value + value_offset_int };
+			while (have_master && CompareSymbols(master_symbol, new_symbol)) {
+				write_symbol(master_symbol);
+				next_master_symbol();
+			}
+			write_symbol(new_symbol);
+		});
+		while (have_master) {
+			write_symbol(master_symbol);
+			next_master_symbol();
+		}
+
+		std::vector<std::string> input_names;
+		if (exists && master.offset < master.size) {
+			auto [name_count] = Record<Integer<4>>::Read(master);
+			while (name_count--) {
+				auto [name] = BsymName::Read(master);
+				input_names.push_back(name);
+			}
+		}
+		for (const auto& input_file_name : this->input_file_names) {
+			if (std::find(input_names.begin(), input_names.end(), input_file_name) == input_names.end()) {
+				input_names.push_back(input_file_name);
+			}
+		}
+
+		StoreNumber(output, input_names.size(), 4);
+		for (const auto& input_name : input_names) {
+			StoreString(output, input_name);
+		}
+
+		output.seekp(4);
+		StoreNumber(output, output_count, 4);
+		output.close();
+	} catch (...) {
+		output.close();
+		std::remove(temp_file_name.c_str());
+		throw;
+	}
+
+	if (output.fail()) {
+		std::remove(temp_file_name.c_str());
+		throw std::runtime_error("Failed to write output.");
+	}
+	CommitFile(temp_file_name, file_name);
+}
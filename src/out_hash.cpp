@@ -0,0 +1,421 @@
+/*
+	Copyright (c) 2025 Devon Artmeier
+
+	Permission to use, copy, modify, and /or distribute this software
+	for any purpose with or without fee is hereby granted.
+
+	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
+	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
+	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+	PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "shared.hpp"
+
+static const uint32_t HASH_SEED          = 0x811C9DC5;
+static const uint32_t HASH_PRIME         = 0x01000193;
+static const int32_t  MAX_DISPLACEMENT   = 0x100000;
+static const size_t   MAX_HASH_SEEDS     = 64;
+static const size_t   HASH_VALUES_A_LINE = 8;
+
+struct PerfectHash
+{
+	uint32_t                   seed;
+	std::vector<int32_t>       displacements;
+	std::vector<const Symbol*> slots;
+};
+
+static inline uint32_t HashName(uint32_t hash, const std::string& name)
+{
+	for (const auto& c : name) {
+		hash = (hash ^ static_cast<unsigned char>(c)) * HASH_PRIME;
+	}
+	return hash;
+}
+
+// Hash and displace: names are grouped into buckets by a seeded hash, and every
+// bucket is given either a second hash seed that spreads it over free slots, or
+// (for single names) the slot itself, stored as -(slot + 1)
+static bool BuildPerfectHash(const std::vector<Symbol>& symbols, const uint32_t seed, PerfectHash& hash)
+{
+	size_t                            count = symbols.size();
+	std::vector<std::vector<size_t>>  buckets(count);
+	std::vector<size_t>               bucket_order;
+	std::vector<size_t>               slot_marks(count, 0);
+	std::vector<size_t>               positions;
+
+	hash.seed = seed;
+	hash.displacements.assign(count, 0);
+	hash.slots.assign(count, nullptr);
+
+	for (size_t i = 0; i < count; i++) {
+		buckets[HashName(seed, symbols[i].name) % count].push_back(i);
+	}
+	for (size_t i = 0; i < count; i++) {
+		if (!buckets[i].empty()) {
+			bucket_order.push_back(i);
+		}
+	}
+	std::stable_sort(bucket_order.begin(), bucket_order.end(), [&](const size_t bucket_1, const size_t bucket_2) {
+		return buckets[bucket_1].size() > buckets[bucket_2].size();
+	});
+
+	size_t order_index = 0;
+	size_t mark        = 0;
+
+	for (; order_index < bucket_order.size() && buckets[bucket_order[order_index]].size() > 1; order_index++) {
+		const std::vector<size_t>& bucket = buckets[bucket_order[order_index]];
+		int32_t                    displacement;
+
+		for (displacement = 1; displacement < MAX_DISPLACEMENT; displacement++) {
+			bool placed = true;
+
+			mark++;
+			positions.clear();
+			for (const auto& symbol : bucket) {
+				size_t position = HashName(static_cast<uint32_t>(displacement), symbols[symbol].name) % count;
+				if (hash.slots[position] != nullptr || slot_marks[position] == mark) {
+					placed = false;
+					break;
+				}
+				slot_marks[position] = mark;
+				positions.push_back(position);
+			}
+
+			if (placed) {
+				break;
+			}
+		}
+		if (displacement == MAX_DISPLACEMENT) {
+			return false;
+		}
+
+		hash.displacements[bucket_order[order_index]] = displacement;
+		for (size_t i = 0; i < bucket.size(); i++) {
+			hash.slots[positions[i]] = &symbols[bucket[i]];
+		}
+	}
+
+	size_t free_slot = 0;
+	for (; order_index < bucket_order.size(); order_index++) {
+		while (hash.slots[free_slot] != nullptr) {
+			free_slot++;
+		}
+		hash.displacements[bucket_order[order_index]] = -static_cast<int32_t>(free_slot) - 1;
+		hash.slots[free_slot]                         = &symbols[buckets[bucket_order[order_index]].front()];
+	}
+
+	return true;
+}
+
+static void BuildPerfectHash(const std::vector<Symbol>& symbols, PerfectHash& hash)
+{
+	// Equal names always share a slot, so no seed could ever separate them
+	std::vector<const std::string*> names;
+	names.reserve(symbols.size());
+	for (const auto& symbol : symbols) {
+		names.push_back(&symbol.name);
+	}
+	std::sort(names.begin(), names.end(), [](const std::string* name_1, const std::string* name_2) {
+		return *name_1 < *name_2;
+	});
+	for (size_t i = 1; i < names.size(); i++) {
+		if (*names[i] == *names[i - 1]) {
+			throw std::runtime_error(("Multiple definitions of symbol \"" + *names[i] + "\" detected.").c_str());
+		}
+	}
+
+	uint32_t seed = HASH_SEED;
+	for (size_t attempt = 0; attempt < MAX_HASH_SEEDS; attempt++) {
+		if (BuildPerfectHash(symbols, seed, hash)) {
+			return;
+		}
+		seed = HashName(seed, "seed");
+	}
+	throw std::runtime_error("Could not build hash table.");
+}
+
+template<typename Dialect>
+static void AppendHashHeader(std::string& buffer, const std::vector<std::string>& input_file_names)
+{
+	const std::string separator = "------------------------------------------------------------------------------";
+
+	AppendComment<Dialect>(buffer, separator);
+	buffer += '\n';
+	AppendComment<Dialect>(buffer, input_file_names.empty() ? "No valid symbol files found" : "Symbols extracted from");
+	buffer += '\n';
+	for (const auto& input_file_name : input_file_names) {
+		AppendComment<Dialect>(buffer, input_file_name);
+		buffer += '\n';
+	}
+	AppendComment<Dialect>(buffer, separator);
+	buffer += "\n\n";
+}
+
+template<typename Dialect>
+static void AppendHashFooter(std::string& buffer)
+{
+	buffer += '\n';
+	AppendComment<Dialect>(buffer, "------------------------------------------------------------------------------");
+}
+
+template<typename Dialect, ValueType value_type, NumberBase number_base>
+static void AppendHashValue(std::string& buffer, const Symbol& symbol, const std::string& value_offset)
+{
+	AppendValue<Dialect, value_type, number_base>(buffer, symbol.value);
+	if (!value_offset.empty()) {
+		buffer += '+';
+		buffer += value_offset;
+	}
+}
+
+template<typename Dialect, ValueType value_type, NumberBase number_base>
+static void AppendCHashTable(std::string& buffer, const PerfectHash& hash, const std::string& value_offset)
+{
+	constexpr const char* c_type = value_type == ValueType::Unsigned32 ? "uint32_t" :
+	                               value_type == ValueType::Unsigned64 ? "uint64_t" :
+	                               value_type == ValueType::Signed32   ? "int32_t"  : "int64_t";
+	size_t count = hash.slots.size();
+
+	buffer += "#include <stdint.h>\n#include <string.h>\n\n";
+	buffer += "#define SYMBOL_COUNT     (" + std::to_string(count) + ")\n";
+	buffer += "#define SYMBOL_HASH_SEED (0x";
+	AppendHex(buffer, hash.seed);
+	buffer += "u)\n\n";
+
+	if (count != 0) {
+		buffer += "static const int32_t symbol_displacements[SYMBOL_COUNT] = {";
+		for (size_t i = 0; i < count; i++) {
+			buffer += i % HASH_VALUES_A_LINE == 0 ? "\n\t" : " ";
+			AppendDecimal(buffer, hash.displacements[i]);
+			buffer += ',';
+		}
+		buffer += "\n};\n\nstatic const uint32_t symbol_name_offsets[SYMBOL_COUNT] = {";
+
+		size_t name_offset = 0;
+		for (size_t i = 0; i < count; i++) {
+			buffer += i % HASH_VALUES_A_LINE == 0 ? "\n\t" : " ";
+			AppendDecimal(buffer, static_cast<long long>(name_offset));
+			buffer += ',';
+			name_offset += hash.slots[i]->name.size() + 1;
+		}
+		buffer += "\n};\n\nstatic const char symbol_names[] =";
+
+		for (size_t i = 0; i < count; i++) {
+			buffer += "\n\t\"";
+			for (const auto& c : hash.slots[i]->name) {
+				if (c == '"' || c == '\\') {
+					buffer += '\\';
+					buffer += c;
+				} else if (c < ' ' || c > '~') {
+					const unsigned char octal = static_cast<unsigned char>(c);
+					buffer += '\\';
+					buffer += static_cast<char>('0' + ((octal >> 6) & 7));
+					buffer += static_cast<char>('0' + ((octal >> 3) & 7));
+					buffer += static_cast<char>('0' + (octal & 7));
+				} else {
+					buffer += c;
+				}
+			}
+			buffer += i + 1 < count ? "\\0\"" : "\"";
+		}
+		buffer += ";\n\nstatic const ";
+		buffer += c_type;
+		buffer += " symbol_values[SYMBOL_COUNT] = {";
+
+		for (size_t i = 0; i < count; i++) {
+			buffer += "\n\t";
+			AppendHashValue<Dialect, value_type, number_base>(buffer, *hash.slots[i], value_offset);
+			buffer += ',';
+		}
+		buffer += "\n};\n\n";
+
+		buffer += "static uint32_t symbol_hash(uint32_t hash, const char* name)\n"
+		          "{\n"
+		          "\twhile (*name != '\\0') {\n"
+		          "\t\thash = (hash ^ (unsigned char)*name++) * 0x";
+		AppendHex(buffer, HASH_PRIME);
+		buffer += "u;\n"
+		          "\t}\n"
+		          "\treturn hash;\n"
+		          "}\n\n";
+	}
+
+	buffer += "static int symbol_lookup(const char* name, ";
+	buffer += c_type;
+	buffer += "* value)\n{\n";
+	if (count != 0) {
+		buffer += "\tint32_t  displacement = symbol_displacements[symbol_hash(SYMBOL_HASH_SEED, name) % SYMBOL_COUNT];\n"
+		          "\tuint32_t index        = displacement < 0 ? (uint32_t)(-(displacement + 1)) :\n"
+		          "\t                                           symbol_hash((uint32_t)displacement, name) % SYMBOL_COUNT;\n\n"
+		          "\tif (strcmp(symbol_names + symbol_name_offsets[index], name) != 0) {\n"
+		          "\t\treturn 0;\n"
+		          "\t}\n"
+		          "\t*value = symbol_values[index];\n"
+		          "\treturn 1;\n";
+	} else {
+		buffer += "\t(void)name;\n\t(void)value;\n\treturn 0;\n";
+	}
+	buffer += "}\n";
+}
+
+template<typename Dialect, ValueType value_type, NumberBase number_base>
+static void AppendAsmHashTable(std::string& buffer, const PerfectHash& hash, const std::string& value_offset)
+{
+	size_t count = hash.slots.size();
+
+	AppendComment<Dialect>(buffer, "Lookup: h = SYMBOL_HASH_SEED, then h = (h ^ c) * 16777619 for each name byte");
+	buffer += '\n';
+	AppendComment<Dialect>(buffer, "d = SymbolDisplacements[h % SYMBOL_COUNT], slot = -d-1 if d < 0, else the same hash");
+	buffer += '\n';
+	AppendComment<Dialect>(buffer, "seeded with d, % SYMBOL_COUNT. The name at SymbolNames+SymbolNameOffsets[slot]");
+	buffer += '\n';
+	AppendComment<Dialect>(buffer, "must match, and its value is at SymbolValues[slot]");
+	buffer += "\n\n";
+
+	AppendSymbolLine<Dialect, ValueType::Unsigned32, NumberBase::Decimal>(buffer, { "SYMBOL_COUNT", static_cast<long long>(count) }, 17, "");
+	AppendSymbolLine<Dialect, ValueType::Unsigned32, NumberBase::Hex>(buffer, { "SYMBOL_HASH_SEED", static_cast<long long>(hash.seed) }, 17, "");
+
+	buffer += "\nSymbolDisplacements:";
+	for (size_t i = 0; i < count; i++) {
+		buffer += i % HASH_VALUES_A_LINE == 0 ? "\n" : ", ";
+		if (i % HASH_VALUES_A_LINE == 0) {
+			buffer += Dialect::data_long;
+		}
+		AppendDecimal(buffer, hash.displacements[i]);
+	}
+
+	buffer += "\n\nSymbolNameOffsets:";
+	size_t name_offset = 0;
+	for (size_t i = 0; i < count; i++) {
+		buffer += i % HASH_VALUES_A_LINE == 0 ? "\n" : ", ";
+		if (i % HASH_VALUES_A_LINE == 0) {
+			buffer += Dialect::data_long;
+		}
+		AppendDecimal(buffer, static_cast<long long>(name_offset));
+		name_offset += hash.slots[i]->name.size() + 1;
+	}
+
+	buffer += "\n\nSymbolNames:";
+	for (size_t i = 0; i < count; i++) {
+		buffer += '\n';
+		buffer += Dialect::data_string;
+		buffer += hash.slots[i]->name;
+		buffer += Dialect::string_end;
+	}
+
+	buffer += "\n\nSymbolValues:";
+	for (size_t i = 0; i < count; i++) {
+		buffer += '\n';
+		buffer += Dialect::data_long;
+		AppendHashValue<Dialect, value_type, number_base>(buffer, *hash.slots[i], value_offset);
+	}
+	buffer += '\n';
+}
+
+template<typename Dialect, bool is_c, ValueType value_type, NumberBase number_base>
+static void AppendHashTable(std::string& buffer, const PerfectHash& hash, const std::string& value_offset)
+{
+	if constexpr (is_c) {
+		AppendCHashTable<Dialect, value_type, number_base>(buffer, hash, value_offset);
+	} else {
+		AppendAsmHashTable<Dialect, value_type, number_base>(buffer, hash, value_offset);
+	}
+}
+
+template<typename Dialect, bool is_c, ValueType value_type>
+static void AppendHashTable(std::string& buffer, const PerfectHash& hash, const NumberBase number_base, const std::string& value_offset)
+{
+	switch (number_base) {
+		case NumberBase::Hex:
+			AppendHashTable<Dialect, is_c, value_type, NumberBase::Hex>(buffer, hash, value_offset);
+			break;
+		case NumberBase::Decimal:
+			AppendHashTable<Dialect, is_c, value_type, NumberBase::Decimal>(buffer, hash, value_offset);
+			break;
+		case NumberBase::Binary:
+			AppendHashTable<Dialect, is_c, value_type, NumberBase::Binary>(buffer, hash, value_offset);
+			break;
+	}
+}
+
+template<typename Dialect, bool is_c>
+static void AppendHashOutput(std::string& buffer, const std::vector<std::string>& input_file_names, const PerfectHash& hash,
+                             const ValueType value_type, const NumberBase number_base, const std::string& value_offset)
+{
+	AppendHashHeader<Dialect>(buffer, input_file_names);
+
+	switch (value_type) {
+		case ValueType::Unsigned32:
+			AppendHashTable<Dialect, is_c, ValueType::Unsigned32>(buffer, hash, number_base, value_offset);
+			break;
+		case ValueType::Unsigned64:
+			AppendHashTable<Dialect, is_c, ValueType::Unsigned64>(buffer, hash, number_base, value_offset);
+			break;
+		case ValueType::Signed32:
+			AppendHashTable<Dialect, is_c, ValueType::Signed32>(buffer, hash, number_base, value_offset);
+			break;
+		case ValueType::Signed64:
+			AppendHashTable<Dialect, is_c, ValueType::Signed64>(buffer, hash, number_base, value_offset);
+			break;
+	}
+
+	AppendHashFooter<Dialect>(buffer);
+}
+
+void Symbols::OutputCHash(std::ostream& output, const ValueType value_type, const NumberBase number_base)
+{
+	std::vector<Symbol> hash_symbols;
+	std::string         buffer;
+	PerfectHash         hash;
+
+	hash_symbols.reserve(this->GetOutputCount());
+	this->ForEachOutputSymbol([&](const Symbol& symbol) {
+		hash_symbols.push_back(symbol);
+	});
+	BuildPerfectHash(hash_symbols, hash);
+
+	AppendHashOutput<CDialect, true>(buffer, this->input_file_names, hash, value_type, number_base, this->value_offset);
+	output.write(buffer.data(), buffer.size());
+}
+
+void Symbols::OutputAsmHash(std::ostream& output, const ValueType value_type, const NumberBase number_base, const AsmDialect asm_dialect)
+{
+	if (value_type == ValueType::Unsigned64 || value_type == ValueType::Signed64) {
+		throw std::runtime_error("Assembly lookup tables only support 32-bit values.");
+	}
+
+	std::vector<Symbol> hash_symbols;
+	std::string         buffer;
+	PerfectHash         hash;
+
+	hash_symbols.reserve(this->GetOutputCount());
+	this->ForEachOutputSymbol([&](const Symbol& symbol) {
+		hash_symbols.push_back(symbol);
+	});
+	BuildPerfectHash(hash_symbols, hash);
+
+	switch (asm_dialect) {
+		case AsmDialect::Asm68k:
+			AppendHashOutput<Asm68kDialect, false>(buffer, this->input_file_names, hash, value_type, number_base, this->value_offset);
+			break;
+		case AsmDialect::Vasm:
+			AppendHashOutput<VasmDialect, false>(buffer, this->input_file_names, hash, value_type, number_base, this->value_offset);
+			break;
+		case AsmDialect::Ca65:
+			AppendHashOutput<Ca65Dialect, false>(buffer, this->input_file_names, hash, value_type, number_base, this->value_offset);
+			break;
+		case AsmDialect::Nasm:
+			AppendHashOutput<NasmDialect, false>(buffer, this->input_file_names, hash, value_type, number_base, this->value_offset);
+			break;
+		case AsmDialect::Gas:
+			AppendHashOutput<GasDialect, false>(buffer, this->input_file_names, hash, value_type, number_base, this->value_offset);
+			break;
+	}
+
+	output.write(buffer.data(), buffer.size());
+}
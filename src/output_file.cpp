@@ -0,0 +1,174 @@
+/*
+	Copyright (c) 2025 Devon Artmeier
+
+	Permission to use, copy, modify, and /or distribute this software
+	for any purpose with or without fee is hereby granted.
+
+	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
+	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
+	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+	PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "shared.hpp"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+OutputFile::~OutputFile()
+{
+	try {
+		this->Close();
+	} catch (...) {
+	}
+}
+
+bool OutputFile::Open(const std::string& file_name)
+{
+	if (file_name.compare("-") == 0) {
+		this->fd      = STDOUT_FILENO;
+		this->owns_fd = false;
+	} else {
+		this->fd      = open(file_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+		this->owns_fd = true;
+	}
+
+	if (this->fd < 0) {
+		return false;
+	}
+
+	this->buffer.resize(OUTPUT_BUFFER_SIZE);
+	this->setp(this->buffer.data(), this->buffer.data() + this->buffer.size());
+	return true;
+}
+
+void OutputFile::Close()
+{
+	if (this->fd < 0) {
+		return;
+	}
+
+	bool flushed = this->sync() == 0;
+	if (this->owns_fd && close(this->fd) != 0) {
+		flushed = false;
+	}
+	this->fd = -1;
+
+	if (!flushed) {
+		throw std::runtime_error("Failed to write output.");
+	}
+}
+
+void OutputFile::WriteGathered(const std::vector<std::string>& buffers)
+{
+	if (this->sync() != 0) {
+		throw std::runtime_error("Failed to write output.");
+	}
+
+	std::vector<iovec> vectors;
+	for (const auto& buffer : buffers) {
+		if (!buffer.empty()) {
+			vectors.push_back({ const_cast<char*>(buffer.data()), buffer.size() });
+		}
+	}
+
+	size_t vector_index = 0;
+	while (vector_index < vectors.size()) {
+		int     vector_count = static_cast<int>(std::min<size_t>(vectors.size() - vector_index, IOV_MAX));
+		ssize_t written      = writev(this->fd, vectors.data() + vector_index, vector_count);
+
+		if (written < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			throw std::runtime_error("Failed to write output.");
+		}
+
+		size_t remaining = static_cast<size_t>(written);
+		while (vector_index < vectors.size() && remaining >= vectors[vector_index].iov_len) {
+			remaining -= vectors[vector_index++].iov_len;
+		}
+		if (remaining != 0) {
+			vectors[vector_index].iov_base = static_cast<char*>(vectors[vector_index].iov_base) + remaining;
+			vectors[vector_index].iov_len -= remaining;
+		}
+	}
+}
+
+OutputFile::int_type OutputFile::overflow(int_type c)
+{
+	if (this->sync() != 0) {
+		return traits_type::eof();
+	}
+	if (!traits_type::eq_int_type(c, traits_type::eof())) {
+		*this->pptr() = traits_type::to_char_type(c);
+		this->pbump(1);
+	}
+	return traits_type::not_eof(c);
+}
+
+std::streamsize OutputFile::xsputn(const char* data, std::streamsize count)
+{
+	if (count <= this->epptr() - this->pptr()) {
+		memcpy(this->pptr(), data, static_cast<size_t>(count));
+		this->pbump(static_cast<int>(count));
+		return count;
+	}
+
+	if (this->sync() != 0 || !this->WriteAll(data, static_cast<size_t>(count))) {
+		return 0;
+	}
+	return count;
+}
+
+int OutputFile::sync()
+{
+	size_t count = static_cast<size_t>(this->pptr() - this->pbase());
+	if (count != 0) {
+		if (!this->WriteAll(this->pbase(), count)) {
+			return -1;
+		}
+		this->setp(this->buffer.data(), this->buffer.data() + this->buffer.size());
+	}
+	return 0;
+}
+
+bool OutputFile::WriteAll(const char* data, size_t count)
+{
+	while (count != 0) {
+		ssize_t written = write(this->fd, data, count);
+		if (written < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return false;
+		}
+		data  += written;
+		count -= static_cast<size_t>(written);
+	}
+	return true;
+}
+
+#endif
+
+void WriteBuffers(std::ostream& output, const std::vector<std::string>& buffers)
+{
+#ifndef _WIN32
+	OutputFile* file = dynamic_cast<OutputFile*>(output.rdbuf());
+	if (file != nullptr) {
+		file->WriteGathered(buffers);
+		return;
+	}
+#endif
+
+	for (const auto& buffer : buffers) {
+		output.write(buffer.data(), buffer.size());
+	}
+}
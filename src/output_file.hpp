@@ -0,0 +1,48 @@
+/*
+	Copyright (c) 2025 Devon Artmeier
+
+	Permission to use, copy, modify, and /or distribute this software
+	for any purpose with or without fee is hereby granted.
+
+	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
+	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
+	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+	PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef OUTPUT_FILE_HPP
+#define OUTPUT_FILE_HPP
+
+#ifndef _WIN32
+
+class OutputFile : public std::streambuf
+{
+public:
+	~OutputFile() override;
+
+	bool Open         (const std::string& file_name);
+	void Close        ();
+	void WriteGathered(const std::vector<std::string>& buffers);
+
+protected:
+	int_type        overflow(int_type c) override;
+	std::streamsize xsputn  (const char* data, std::streamsize count) override;
+	int             sync    () override;
+
+private:
+	bool WriteAll(const char* data, size_t count);
+
+	int               fd       { -1 };
+	bool              owns_fd  { false };
+	std::vector<char> buffer;
+};
+
+#endif
+
+extern void WriteBuffers(std::ostream& output, const std::vector<std::string>& buffers);
+
+#endif // OUTPUT_FILE_HPP
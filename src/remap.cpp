@@ -0,0 +1,157 @@
+/*
+	Copyright (c) 2025 Devon Artmeier
+
+	Permission to use, copy, modify, and /or distribute this software
+	for any purpose with or without fee is hereby granted.
+
+	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
+	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
+	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+	PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "shared.hpp"
+
+static long long ParseRemapValue(const std::string& value_str, const std::string& range)
+{
+	long long value = 0;
+	if (!ParseHexValue(value_str, value)) {
+		throw std::runtime_error(("Invalid remap range \"" + range + "\".").c_str());
+	}
+	return value;
+}
+
+static bool CompareRemapRanges(const RemapRange& range_1, const RemapRange& range_2)
+{
+	return range_1.start < range_2.start;
+}
+
+void Symbols::AddRemapRange(const std::string& range)
+{
+	size_t dash   = range.find('-', 1);
+	size_t equals = range.find('=');
+	if (dash == std::string::npos || equals == std::string::npos || equals < dash) {
+		throw std::runtime_error(("Invalid remap range \"" + range + "\".").c_str());
+	}
+
+	RemapRange remap_range;
+	remap_range.start  = NormalizeAddress(ParseRemapValue(range.substr(0, dash), range));
+	remap_range.end    = NormalizeAddress(ParseRemapValue(range.substr(dash + 1, equals - dash - 1), range));
+	remap_range.target = ParseRemapValue(range.substr(equals + 1), range);
+
+	if (remap_range.end < remap_range.start) {
+		throw std::runtime_error(("Invalid remap range \"" + range + "\".").c_str());
+	}
+
+	this->remap_ranges.push_back(remap_range);
+	this->remap_compiled = false;
+}
+
+void Symbols::AddRemapFile(const std::string& file_name)
+{
+	std::vector<unsigned char> buffer;
+	ReadFile(file_name, buffer);
+
+	InputBuffer input = { buffer.data(), buffer.size(), 0 };
+	std::string line;
+
+	while (ReadInputLine(input, line)) {
+		size_t comment = line.find_first_of(";#");
+		if (comment != std::string::npos) {
+			line.erase(comment);
+		}
+
+		line.erase(std::remove_if(line.begin(), line.end(), [](unsigned char c) { return std::isspace(c); }), line.end());
+		if (!line.empty()) {
+			this->AddRemapRange(line);
+		}
+	}
+}
+
+void Symbols::SetUnmappedMode(const std::string& mode)
+{
+	std::string mode_lower = StringToLower(mode);
+
+	if (mode_lower.compare("keep") == 0) {
+		this->unmapped_mode = UnmappedMode::Keep;
+	} else if (mode_lower.compare("drop") == 0) {
+		this->unmapped_mode = UnmappedMode::Drop;
+	} else if (mode_lower.compare("error") == 0) {
+		this->unmapped_mode = UnmappedMode::Error;
+	} else {
+		throw std::runtime_error(("Invalid unmapped symbol mode \"" + mode + "\".").c_str());
+	}
+}
+
+void Symbols::CompileRemapRanges()
+{
+	if (this->remap_compiled) {
+		return;
+	}
+
+	std::sort(this->remap_ranges.begin(), this->remap_ranges.end(), CompareRemapRanges);
+	for (size_t i = 1; i < this->remap_ranges.size(); i++) {
+		if (this->remap_ranges[i].start <= this->remap_ranges[i - 1].end) {
+			throw std::runtime_error("Remap ranges overlap.");
+		}
+	}
+
+	this->remap_compiled = true;
+}
+
+bool Symbols::RemapUnmappedSymbol(const Symbol& symbol)
+{
+	switch (this->unmapped_mode) {
+		case UnmappedMode::Keep:
+			this->unmapped_count++;
+			return true;
+		case UnmappedMode::Drop:
+			return false;
+		case UnmappedMode::Error:
+			throw std::runtime_error(("Symbol \"" + symbol.name + "\" is outside of every remap range.").c_str());
+	}
+	return true;
+}
+
+bool Symbols::RemapSymbol(Symbol& symbol)
+{
+	long long address = NormalizeAddress(symbol.value);
+	auto      range   = std::upper_bound(this->remap_ranges.begin(), this->remap_ranges.end(), address,
+	                                     [](const long long value, const RemapRange& range) { return value < range.start; });
+
+	if (range == this->remap_ranges.begin() || address > (--range)->end) {
+		return this->RemapUnmappedSymbol(symbol);
+	}
+
+	symbol.value = address - range->start + range->target;
+	return true;
+}
+
+void Symbols::RemapOutputSymbols()
+{
+	size_t count = 0;
+
+	// Normalized addresses are not in value order, so every symbol looks up its own range.
+	for (auto& symbol : this->symbols_out) {
+		if (!this->RemapSymbol(symbol)) {
+			continue;
+		}
+
+		if (count != static_cast<size_t>(&symbol - this->symbols_out.data())) {
+			this->symbols_out[count] = std::move(symbol);
+		}
+		count++;
+	}
+	this->symbols_out.resize(count);
+}
+
+void Symbols::ReportUnmappedSymbols()
+{
+	if (this->unmapped_count != 0) {
+		std::cerr << "Warning: " << this->unmapped_count << " symbol(s) are outside of every remap range and were left unchanged." << std::endl;
+	}
+}
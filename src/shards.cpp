@@ -0,0 +1,195 @@
+/*
+	Copyright (c) 2025 Devon Artmeier
+
+	Permission to use, copy, modify, and /or distribute this software
+	for any purpose with or without fee is hereby granted.
+
+	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
+	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
+	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+	PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "shared.hpp"
+
+static bool CompareShardRanges(const Shard* shard_1, const Shard* shard_2)
+{
+	return shard_1->start < shard_2->start;
+}
+
+void Symbols::AddShard(const std::string& shard)
+{
+	size_t equals = shard.find_last_of('=');
+	if (equals == std::string::npos || equals == 0 || equals == shard.size() - 1 || shard.compare(0, equals, "-") == 0) {
+		throw std::runtime_error(("Invalid shard \"" + shard + "\".").c_str());
+	}
+
+	Shard       new_shard = { shard.substr(0, equals), "", 0, 0, false };
+	std::string selector  = shard.substr(equals + 1);
+
+	if (selector.back() == '*') {
+		new_shard.prefix    = selector.substr(0, selector.size() - 1);
+		new_shard.is_prefix = true;
+	} else {
+		size_t dash = selector.find('-', 1);
+		if (dash == std::string::npos || !ParseHexValue(selector.substr(0, dash), new_shard.start) ||
+		    !ParseHexValue(selector.substr(dash + 1), new_shard.end)) {
+			throw std::runtime_error(("Invalid shard \"" + shard + "\".").c_str());
+		}
+		new_shard.start = NormalizeAddress(new_shard.start);
+		new_shard.end   = NormalizeAddress(new_shard.end);
+		if (new_shard.end < new_shard.start) {
+			throw std::runtime_error(("Invalid shard \"" + shard + "\".").c_str());
+		}
+	}
+
+	if (!this->shards.empty() && this->shards.front().is_prefix != new_shard.is_prefix) {
+		throw std::runtime_error("Shards must either all be address ranges or all be prefixes.");
+	}
+	if (this->max_memory != 0) {
+		throw std::runtime_error("Sharded output cannot be used with a memory limit.");
+	}
+	if (new_shard.file_name.compare(this->output_file) == 0) {
+		throw std::runtime_error(("Shard file \"" + new_shard.file_name + "\" is also the output file.").c_str());
+	}
+	for (const auto& existing_shard : this->shards) {
+		if (existing_shard.file_name.compare(new_shard.file_name) == 0) {
+			throw std::runtime_error(("Shard file \"" + new_shard.file_name + "\" is used more than once.").c_str());
+		}
+		if (new_shard.is_prefix && existing_shard.prefix.compare(new_shard.prefix) == 0) {
+			throw std::runtime_error(("Shard prefix \"" + new_shard.prefix + "\" is used more than once.").c_str());
+		}
+	}
+	this->shards.push_back(new_shard);
+}
+
+void Symbols::AddShardFile(const std::string& file_name)
+{
+	std::vector<unsigned char> buffer;
+	ReadFile(file_name, buffer);
+
+	InputBuffer input = { buffer.data(), buffer.size(), 0 };
+	std::string line;
+
+	while (ReadInputLine(input, line)) {
+		size_t start = line.find_first_not_of(" \t");
+		size_t end   = line.find_last_not_of(" \t");
+		if (start != std::string::npos && line[start] != ';' && line[start] != '#') {
+			this->AddShard(line.substr(start, end - start + 1));
+		}
+	}
+}
+
+bool Symbols::HasShards()
+{
+	return !this->shards.empty();
+}
+
+void Symbols::AssignShards(std::vector<std::vector<Symbol>>& shard_symbols)
+{
+	shard_symbols.assign(this->shards.size(), std::vector<Symbol>());
+
+	if (this->shards.front().is_prefix) {
+		std::unordered_map<std::string, size_t> prefixes;
+		std::vector<size_t>                     prefix_lengths;
+
+		for (size_t i = 0; i < this->shards.size(); i++) {
+			prefixes[this->shards[i].prefix] = i;
+			prefix_lengths.push_back(this->shards[i].prefix.size());
+		}
+		std::sort(prefix_lengths.begin(), prefix_lengths.end(), std::greater<size_t>());
+		prefix_lengths.erase(std::unique(prefix_lengths.begin(), prefix_lengths.end()), prefix_lengths.end());
+
+		std::string prefix;
+		for (const auto& symbol : this->symbols_out) {
+			size_t name_length = symbol.name.size() - this->prefix_add.size() - this->suffix_add.size();
+
+			for (const auto& prefix_length : prefix_lengths) {
+				if (prefix_length > name_length) {
+					continue;
+				}
+
+				prefix.assign(symbol.name, this->prefix_add.size(), prefix_length);
+				auto shard = prefixes.find(prefix);
+				if (shard != prefixes.end()) {
+					shard_symbols[shard->second].push_back(symbol);
+					break;
+				}
+			}
+		}
+	} else {
+		std::vector<const Shard*> ranges;
+		for (const auto& shard : this->shards) {
+			ranges.push_back(&shard);
+		}
+		std::sort(ranges.begin(), ranges.end(), CompareShardRanges);
+
+		for (size_t i = 1; i < ranges.size(); i++) {
+			if (ranges[i]->start <= ranges[i - 1]->end) {
+				throw std::runtime_error("Shard address ranges overlap.");
+			}
+		}
+
+		// Normalized addresses are not in value order, so every symbol looks up its own range.
+		for (const auto& symbol : this->symbols_out) {
+			long long address = NormalizeAddress(symbol.value);
+			auto      range   = std::upper_bound(ranges.begin(), ranges.end(), address,
+			                                     [](const long long value, const Shard* shard) { return value < shard->start; });
+
+			if (range != ranges.begin() && address <= (*--range)->end) {
+				shard_symbols[*range - this->shards.data()].push_back(symbol);
+			}
+		}
+	}
+}
+
+void Symbols::OutputShards(const ValueType value_type, const NumberBase number_base, const OutputMode output_mode, const AsmDialect asm_dialect)
+{
+	if (this->shards.empty()) {
+		return;
+	}
+	std::vector<std::vector<Symbol>> shard_symbols;
+	this->AssignShards(shard_symbols);
+
+	std::vector<std::exception_ptr> errors(this->shards.size());
+	std::atomic<size_t>             next_shard(0);
+	size_t                          thread_count = std::min<size_t>(std::max(1U, std::thread::hardware_concurrency()), this->shards.size());
+
+	auto output_shards = [&]() {
+		size_t shard;
+		while ((shard = next_shard++) < this->shards.size()) {
+			try {
+				Symbols shard_output;
+				shard_output.input_file_names = this->input_file_names;
+				shard_output.value_offset     = this->value_offset;
+				shard_output.symbols_out      = std::move(shard_symbols[shard]);
+				for (const auto& symbol : shard_output.symbols_out) {
+					shard_output.output_length = std::max(shard_output.output_length, static_cast<int>(symbol.name.size()));
+				}
+
+				shard_output.Output(this->shards[shard].file_name, value_type, number_base, output_mode, asm_dialect);
+			} catch (...) {
+				errors[shard] = std::current_exception();
+			}
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (size_t i = 1; i < thread_count; i++) {
+		threads.emplace_back(output_shards);
+	}
+	output_shards();
+	for (auto& thread : threads) {
+		thread.join();
+	}
+
+	for (const auto& error : errors) {
+		if (error) {
+			std::rethrow_exception(error);
+		}
+	}
+}
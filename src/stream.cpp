@@ -0,0 +1,161 @@
+/*
+	Copyright (c) 2025 Devon Artmeier
+
+	Permission to use, copy, modify, and /or distribute this software
+	for any purpose with or without fee is hereby granted.
+
+	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
+	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
+	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+	PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "shared.hpp"
+
+static bool CompareSymbols(const Symbol& symbol_1, const Symbol& symbol_2)
+{
+	return symbol_1.value < symbol_2.value || (symbol_1.value == symbol_2.value && symbol_1.name < symbol_2.name);
+}
+
+void Symbols::SetStream()
+{
+	this->stream = true;
+}
+
+bool Symbols::CanStream(const std::vector<std::string>& file_names)
+{
+	return this->stream && file_names.size() == 1 && this->max_memory == 0 && !this->track_inputs &&
+	       this->remap_ranges.empty() && this->shards.empty();
+}
+
+void Symbols::OpenStream(const std::string& file_name)
+{
+#ifndef _WIN32
+	if (file_name.compare("-") != 0 && this->stream_file.Open(file_name)) {
+		this->stream_data = this->stream_file.GetData();
+		this->stream_size = this->stream_file.GetSize();
+	} else
+#endif
+	{
+		ReadFile(file_name, this->stream_buffer);
+		this->stream_data = this->stream_buffer.data();
+		this->stream_size = this->stream_buffer.size();
+	}
+	this->stream_name = file_name.compare("-") == 0 ? "stdin" : file_name;
+
+	// Measure the output up front, since the binary header and text alignment need it before the first symbol
+	this->output_count  = 0;
+	this->output_length = 0;
+	this->streaming     = true;
+
+	std::vector<size_t> name_hashes;
+	bool ordered = this->StreamInput([&](const Symbol& symbol) {
+		this->output_count++;
+		this->output_length = std::max(this->output_length, static_cast<int>(symbol.name.size()));
+		name_hashes.push_back(std::hash<std::string>()(symbol.name));
+	});
+
+	if (ordered) {
+		this->CheckStreamNames(name_hashes);
+		this->input_file_names.push_back(this->stream_name);
+		return;
+	}
+
+	// Input is not in output order, so it has to go through the symbol table after all
+	this->streaming = false;
+	if (!this->LoadSymbols(this->stream_name, this->stream_data, this->stream_size)) {
+		throw std::runtime_error(("\"" + file_name + "\" is not a valid file.").c_str());
+	}
+	std::vector<unsigned char>().swap(this->stream_buffer);
+}
+
+bool Symbols::StreamInput(const std::function<void(const Symbol&)>& callback)
+{
+	this->stream_callback      = callback;
+	this->stream_ordered       = true;
+	this->stream_have_previous = false;
+	this->stream_group.clear();
+
+	bool valid = this->LoadInputSymbols(this->stream_name, this->stream_data, this->stream_size);
+	if (valid && this->stream_ordered) {
+		this->FlushStreamGroup();
+	}
+	this->stream_callback = nullptr;
+
+	if (!valid) {
+		throw std::runtime_error(("\"" + this->stream_name + "\" is not a valid file.").c_str());
+	}
+	return this->stream_ordered;
+}
+
+void Symbols::StreamSymbol(const std::string& name, long long value)
+{
+	if (!this->stream_ordered) {
+		return;
+	}
+
+	// Inputs only need to be ordered by value, names sharing a value are ordered when their group ends
+	if (!this->stream_group.empty() && value != this->stream_group.back().value) {
+		if (value < this->stream_group.back().value) {
+			this->stream_ordered = false;
+			return;
+		}
+		this->FlushStreamGroup();
+	}
+	this->stream_group.push_back({ this->prefix_add + name + this->suffix_add, value });
+}
+
+void Symbols::FlushStreamGroup()
+{
+	if (this->stream_group.size() > 1) {
+		std::sort(this->stream_group.begin(), this->stream_group.end(), CompareSymbols);
+	}
+
+	// Repeats of the previous symbol with the same value are dropped, like in the symbol table
+	for (auto& symbol : this->stream_group) {
+		if (this->stream_have_previous && symbol.name == this->stream_previous.name && symbol.value == this->stream_previous.value) {
+			continue;
+		}
+
+		this->stream_callback(symbol);
+		std::swap(this->stream_previous, symbol);
+		this->stream_have_previous = true;
+	}
+	this->stream_group.clear();
+}
+
+void Symbols::CheckStreamNames(std::vector<size_t>& name_hashes)
+{
+	// Values are in order, so a name that comes back later always has a different value. Only names
+	// sharing a hash are compared, which takes one more pass over the input if there are any.
+	std::sort(name_hashes.begin(), name_hashes.end());
+
+	std::unordered_set<size_t> repeated_hashes;
+	for (size_t i = 1; i < name_hashes.size(); i++) {
+		if (name_hashes[i] == name_hashes[i - 1]) {
+			repeated_hashes.insert(name_hashes[i]);
+		}
+	}
+	std::vector<size_t>().swap(name_hashes);
+
+	if (repeated_hashes.empty()) {
+		return;
+	}
+
+	std::unordered_set<std::string> names;
+	this->StreamInput([&](const Symbol& symbol) {
+		if (repeated_hashes.count(std::hash<std::string>()(symbol.name)) != 0 && !names.insert(symbol.name).second) {
+			std::string name = symbol.name.substr(this->prefix_add.size(), symbol.name.size() - this->prefix_add.size() - this->suffix_add.size());
+			throw std::runtime_error(("Multiple definitions of symbol \"" + name + "\" detected.").c_str());
+		}
+	});
+}
+
+void Symbols::StreamOutputSymbols(const std::function<void(const Symbol&)>& callback)
+{
+	this->StreamInput(callback);
+}
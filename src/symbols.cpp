@@ -1,192 +1,518 @@
-/*
-	Copyright (c) 2025 Devon Artmeier
-
-	Permission to use, copy, modify, and /or distribute this software
-	for any purpose with or without fee is hereby granted.
-
-	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
-	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
-	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
-	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
-	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
-	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
-	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
-	PERFORMANCE OF THIS SOFTWARE.
-*/
-
-#include "shared.hpp"
-
-static bool CompareSymbols(const Symbol symbol_1, const Symbol symbol_2)
-{
-	return symbol_1.value < symbol_2.value;
-}
-
-void Symbols::LoadSymbols(const std::string& file_name)
-{
-	this->input_file_names.push_back(file_name);
-
-	if (this->LoadBinarySymbols(file_name)) {
-		return;
-	}
-	if (this->LoadPsyqSymbols(file_name)) {
-		return;
-	}
-	if (this->LoadVasmLstSymbols(file_name)) {
-		return;
-	}
-	if (this->LoadVasmVobjSymbols(file_name)) {
-		return;
-	}
-	if (this->LoadVlinkSymSymbols(file_name)) {
-		return;
-	}
-
-	throw std::runtime_error(("\"" + file_name + "\" is not a valid file.").c_str());
-}
-
-void Symbols::SetValueOffset(const std::string& offset)
-{
-	if (!this->value_offset.empty()) {
-		throw std::runtime_error("Value offset already defined.");
-	}
-	this->value_offset = offset;
-}
-
-void Symbols::AddSymbolInclude(const std::string& symbol)
-{
-	this->symbol_includes.push_back(symbol);
-}
-
-void Symbols::AddPrefixInclude(const std::string& prefix)
-{
-	this->prefix_includes.push_back(prefix);
-}
-
-void Symbols::AddSuffixInclude(const std::string& suffix)
-{
-	this->suffix_includes.push_back(suffix);
-}
-
-void Symbols::AddSymbolExclude(const std::string& symbol)
-{
-	this->symbol_excludes.push_back(symbol);
-}
-
-void Symbols::AddPrefixExclude(const std::string& prefix)
-{
-	this->prefix_excludes.push_back(prefix);
-}
-
-void Symbols::AddSuffixExclude(const std::string& suffix)
-{
-	this->suffix_excludes.push_back(suffix);
-}
-
-void Symbols::SetPrefixAdd(const std::string& prefix)
-{
-	if (!this->prefix_add.empty()) {
-		throw std::runtime_error("Prefix addition already defined.");
-	}
-	this->prefix_add = prefix;
-}
-
-void Symbols::SetSuffixAdd(const std::string& suffix)
-{
-	if (!this->suffix_add.empty()) {
-		throw std::runtime_error("Prefix addition already defined.");
-	}
-	this->prefix_add = suffix;
-}
-
-void Symbols::GetOutputSymbols()
-{
-	this->symbols_out.clear();
-	for (const auto& symbol : this->symbols) {
-		this->symbols_out.push_back({ this->prefix_add + symbol.first + this->suffix_add, symbol.second });
-	}
-	std::sort(this->symbols_out.begin(), this->symbols_out.end(), CompareSymbols);
-}
-
-void Symbols::Output(const std::string& file_name, const ValueType value_type, const NumberBase number_base, const OutputMode output_mode)
-{
-	switch (output_mode) {
-		case OutputMode::Binary:
-			this->OutputBinary(file_name, value_type, number_base);
-			break;
-		case OutputMode::Asm:
-			this->OutputAsm(file_name, value_type, number_base);
-			break;
-		case OutputMode::C:
-			this->OutputC(file_name, value_type, number_base);
-			break;
-	}
-}
-
-void Symbols::AddSymbol(const std::string& name, long long value)
-{
-	bool dont_filter = this->symbol_includes.empty() && this->prefix_includes.empty() && this->suffix_includes.empty();
-
-	for (const auto& prefix_include : prefix_includes) {
-		if (StringStartsWith(name, prefix_include)) {
-			dont_filter = true;
-			break;
-		}
-	}
-	for (const auto& suffix_include : suffix_includes) {
-		if (StringEndsWith(name, suffix_include)) {
-			dont_filter = true;
-			break;
-		}
-	}
-	for (const auto& prefix_exclude : prefix_excludes) {
-		if (StringStartsWith(name, prefix_exclude)) {
-			dont_filter = false;
-			break;
-		}
-	}
-	for (const auto& suffix_exclude : suffix_excludes) {
-		if (StringEndsWith(name, suffix_exclude)) {
-			dont_filter = false;
-			break;
-		}
-	}
-	for (const auto& symbol_include : symbol_includes) {
-		if (name.compare(symbol_include) == 0) {
-			dont_filter = true;
-			break;
-		}
-	}
-	for (const auto& symbol_exclude : symbol_excludes) {
-		if (name.compare(symbol_exclude) == 0) {
-			dont_filter = false;
-			break;
-		}
-	}
-
-	if (dont_filter) {
-		if (this->symbols.find(name) == this->symbols.end()) {
-			this->symbols[name] = value;
-		} else {
-			if (this->symbols[name] != value) {
-				throw std::runtime_error(("Multiple definitions of symbol \"" + name + "\" detected.").c_str());
-			}
-		}
-	}
-}
-
-int Symbols::GetLineLength()
-{
-	int line_length = 0;
-	for (const auto& symbol : this->symbols_out) {
-		if (symbol.name.size() > line_length) {
-			line_length = symbol.name.size();
-		}
-	}
-
-	if ((line_length & 7) != 0) {
-		line_length &= ~7;
-	}
-	line_length += 8;
-
-	return line_length;
-}
+/*
+	Copyright (c) 2025 Devon Artmeier
+
+	Permission to use, copy, modify, and /or distribute this software
+	for any purpose with or without fee is hereby granted.
+
+	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
+	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
+	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+	PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "shared.hpp"
+
+static const size_t READ_BATCH_SIZE = 1024;
+
+static bool CompareSymbols(const Symbol symbol_1, const Symbol symbol_2)
+{
+	return symbol_1.value < symbol_2.value || (symbol_1.value == symbol_2.value && symbol_1.name < symbol_2.name);
+}
+
+static void ReadSymbolList(const std::string& file_name, std::unordered_set<std::string>& symbol_list)
+{
+	std::vector<unsigned char> buffer;
+	ReadFile(file_name, buffer);
+
+	InputBuffer input = { buffer.data(), buffer.size(), 0 };
+	std::string line;
+
+	while (ReadInputLine(input, line)) {
+		size_t start = line.find_first_not_of(" \t");
+		size_t end   = line.find_last_not_of(" \t");
+		if (start != std::string::npos) {
+			symbol_list.insert(line.substr(start, end - start + 1));
+		}
+	}
+}
+
+Symbols::~Symbols()
+{
+	if (this->name_runs.file != nullptr) {
+		fclose(this->name_runs.file);
+	}
+	if (this->value_runs.file != nullptr) {
+		fclose(this->value_runs.file);
+	}
+}
+
+void Symbols::LoadSymbols(const std::string& file_name)
+{
+#ifndef _WIN32
+	MappedFile mapped_file;
+	if (file_name.compare("-") != 0 && mapped_file.Open(file_name)) {
+		if (!this->LoadSymbols(file_name, mapped_file.GetData(), mapped_file.GetSize())) {
+			throw std::runtime_error(("\"" + file_name + "\" is not a valid file.").c_str());
+		}
+		return;
+	}
+#endif
+
+	std::vector<unsigned char> buffer;
+	ReadFile(file_name, buffer);
+
+	if (!this->LoadSymbols(file_name.compare("-") == 0 ? "stdin" : file_name, buffer.data(), buffer.size())) {
+		throw std::runtime_error(("\"" + file_name + "\" is not a valid file.").c_str());
+	}
+}
+
+void Symbols::LoadSymbols(const std::vector<std::string>& file_names)
+{
+	if (this->CanStream(file_names)) {
+		this->OpenStream(file_names[0]);
+		return;
+	}
+
+	if (this->max_memory != 0 || file_names.size() < 2) {
+		for (const auto& file_name : file_names) {
+			this->LoadSymbols(file_name);
+		}
+		return;
+	}
+
+	for (size_t start = 0; start < file_names.size(); start += READ_BATCH_SIZE) {
+		std::vector<std::string>                batch_names(file_names.begin() + start,
+		                                                    file_names.begin() + std::min(file_names.size(), start + READ_BATCH_SIZE));
+		std::vector<std::vector<unsigned char>> buffers;
+		std::vector<bool>                       mapped;
+		ReadFiles(batch_names, buffers, mapped);
+
+		for (size_t i = 0; i < batch_names.size(); i++) {
+			const std::string& file_name = batch_names[i];
+			if (mapped[i]) {
+				this->LoadSymbols(file_name);
+				continue;
+			}
+			if (!this->LoadSymbols(file_name.compare("-") == 0 ? "stdin" : file_name, buffers[i].data(), buffers[i].size())) {
+				throw std::runtime_error(("\"" + file_name + "\" is not a valid file.").c_str());
+			}
+			std::vector<unsigned char>().swap(buffers[i]);
+		}
+	}
+}
+
+bool Symbols::LoadSymbols(const std::string& input_name, const unsigned char* data, const size_t size)
+{
+	bool loaded = false;
+	try {
+		loaded = this->LoadInputSymbols(input_name, data, size);
+	} catch (...) {
+		this->DiscardInputRun();
+		throw;
+	}
+	if (!loaded) {
+		this->DiscardInputRun();
+		return false;
+	}
+
+	this->input_file_names.push_back(input_name);
+	return true;
+}
+
+bool Symbols::LoadInputSymbols(const std::string& input_name, const unsigned char* data, const size_t size)
+{
+	static bool (Symbols::* const loaders[])(const std::string&, InputBuffer&) = {
+		&Symbols::LoadBinarySymbols,
+		&Symbols::LoadArchiveSymbols,
+		&Symbols::LoadPsyqSymbols,
+		&Symbols::LoadVasmLstSymbols,
+		&Symbols::LoadVasmVobjSymbols,
+		&Symbols::LoadLinkerMapSymbols,
+		&Symbols::LoadVlinkSymSymbols
+	};
+
+	this->current_input = input_name;
+	if (!this->track_inputs && this->max_memory == 0 && !this->streaming) {
+		this->symbol_runs.push_back({ {}, true });
+	}
+
+	for (const auto& loader : loaders) {
+		InputBuffer input = { data, size, 0 };
+		if ((this->*loader)(input_name, input)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void Symbols::DiscardInputRun()
+{
+	// Every symbol an input added is in its run, so a failed input can be taken back out of the table
+	if (this->track_inputs || this->max_memory != 0 || this->streaming || this->symbol_runs.empty()) {
+		return;
+	}
+
+	for (const auto& entry : this->symbol_runs.back().entries) {
+		this->symbols.erase(this->symbols.find(entry->first));
+	}
+	this->symbol_runs.pop_back();
+}
+
+void Symbols::SetValueOffset(const std::string& offset)
+{
+	if (!this->value_offset.empty()) {
+		throw std::runtime_error("Value offset already defined.");
+	}
+	this->value_offset = offset;
+}
+
+void Symbols::SetMaxMemory(const std::string& size)
+{
+	size_t      multiplier = 1;
+	std::string size_str   = StringToLower(size);
+
+	if (StringEndsWith(size_str, "k")) {
+		multiplier = 1024;
+	} else if (StringEndsWith(size_str, "m")) {
+		multiplier = 1024 * 1024;
+	} else if (StringEndsWith(size_str, "g")) {
+		multiplier = 1024 * 1024 * 1024;
+	}
+	if (multiplier != 1) {
+		size_str.pop_back();
+	}
+
+	unsigned long long max_memory = 0;
+	try {
+		size_t end = 0;
+		max_memory = std::stoull(size_str, &end, 10);
+		if (end != size_str.size()) {
+			throw std::invalid_argument(size_str);
+		}
+	} catch (...) {
+		throw std::runtime_error(("Invalid maximum memory size \"" + size + "\".").c_str());
+	}
+
+	if (max_memory > SIZE_MAX / multiplier) {
+		throw std::runtime_error(("Invalid maximum memory size \"" + size + "\".").c_str());
+	}
+	if (this->track_inputs) {
+		throw std::runtime_error("Watch mode cannot be used with a memory limit.");
+	}
+	if (!this->shards.empty()) {
+		throw std::runtime_error("Sharded output cannot be used with a memory limit.");
+	}
+
+	this->max_memory = static_cast<size_t>(max_memory * multiplier);
+	if (this->max_memory < 0x40000) {
+		throw std::runtime_error("Maximum memory size must be at least 256K.");
+	}
+}
+
+void Symbols::SetOutputFile(const std::string& file_name)
+{
+	for (const auto& shard : this->shards) {
+		if (shard.file_name.compare(file_name) == 0) {
+			throw std::runtime_error(("Shard file \"" + file_name + "\" is also the output file.").c_str());
+		}
+	}
+	this->output_file = file_name;
+}
+
+void Symbols::AddSymbolInclude(const std::string& symbol)
+{
+	this->symbol_includes.insert(symbol);
+}
+
+void Symbols::AddPrefixInclude(const std::string& prefix)
+{
+	this->prefix_includes.push_back(prefix);
+}
+
+void Symbols::AddSuffixInclude(const std::string& suffix)
+{
+	this->suffix_includes.push_back(suffix);
+}
+
+void Symbols::AddSymbolExclude(const std::string& symbol)
+{
+	this->symbol_excludes.insert(symbol);
+}
+
+void Symbols::AddSymbolIncludeList(const std::string& file_name)
+{
+	ReadSymbolList(file_name, this->symbol_includes);
+}
+
+void Symbols::AddSymbolExcludeList(const std::string& file_name)
+{
+	ReadSymbolList(file_name, this->symbol_excludes);
+}
+
+void Symbols::AddPrefixExclude(const std::string& prefix)
+{
+	this->prefix_excludes.push_back(prefix);
+}
+
+void Symbols::AddSuffixExclude(const std::string& suffix)
+{
+	this->suffix_excludes.push_back(suffix);
+}
+
+void Symbols::SetPrefixAdd(const std::string& prefix)
+{
+	if (!this->prefix_add.empty()) {
+		throw std::runtime_error("Prefix addition already defined.");
+	}
+	this->prefix_add = prefix;
+}
+
+void Symbols::SetSuffixAdd(const std::string& suffix)
+{
+	if (!this->suffix_add.empty()) {
+		throw std::runtime_error("Prefix addition already defined.");
+	}
+	this->prefix_add = suffix;
+}
+
+void Symbols::GetOutputSymbols()
+{
+	if (this->streaming) {
+		return;
+	}
+
+	if (this->max_memory != 0) {
+		this->MergeSpilledSymbols();
+		return;
+	}
+
+	if (!this->symbol_runs.empty()) {
+		this->MergeSymbolRuns();
+	} else {
+		this->symbols_out.clear();
+		for (const auto& symbol : this->symbols) {
+			this->symbols_out.push_back({ this->prefix_add + symbol.first + this->suffix_add, symbol.second });
+		}
+		std::sort(this->symbols_out.begin(), this->symbols_out.end(), CompareSymbols);
+	}
+
+	if (!this->remap_ranges.empty()) {
+		this->CompileRemapRanges();
+		this->unmapped_count = 0;
+		this->RemapOutputSymbols();
+		if (!std::is_sorted(this->symbols_out.begin(), this->symbols_out.end(), CompareSymbols)) {
+			std::sort(this->symbols_out.begin(), this->symbols_out.end(), CompareSymbols);
+		}
+		this->ReportUnmappedSymbols();
+	}
+
+	this->output_length = 0;
+	for (const auto& symbol : this->symbols_out) {
+		this->output_length = std::max(this->output_length, static_cast<int>(symbol.name.size()));
+	}
+}
+
+void Symbols::MergeSymbolRuns()
+{
+	typedef const std::pair<const std::string, long long>* SymbolEntry;
+
+	// Inputs that were already in value order are kept as runs, everything else is sorted once
+	std::vector<SymbolEntry>                                       unsorted;
+	std::vector<std::pair<const SymbolEntry*, const SymbolEntry*>> runs;
+
+	for (const auto& run : this->symbol_runs) {
+		if (run.sorted) {
+			if (!run.entries.empty()) {
+				runs.push_back({ run.entries.data(), run.entries.data() + run.entries.size() });
+			}
+		} else {
+			unsorted.insert(unsorted.end(), run.entries.begin(), run.entries.end());
+		}
+	}
+	if (!unsorted.empty()) {
+		std::sort(unsorted.begin(), unsorted.end(), [](const SymbolEntry entry_1, const SymbolEntry entry_2) {
+			return entry_1->second < entry_2->second;
+		});
+		runs.push_back({ unsorted.data(), unsorted.data() + unsorted.size() });
+	}
+
+	auto compare_runs = [&](const size_t run_1, const size_t run_2) {
+		return (*runs[run_1].first)->second > (*runs[run_2].first)->second;
+	};
+	std::priority_queue<size_t, std::vector<size_t>, decltype(compare_runs)> merge_queue(compare_runs);
+
+	for (size_t i = 0; i < runs.size(); i++) {
+		merge_queue.push(i);
+	}
+
+	this->symbols_out.clear();
+	this->symbols_out.reserve(this->symbols.size());
+
+	while (!merge_queue.empty()) {
+		size_t run = merge_queue.top();
+		merge_queue.pop();
+
+		SymbolEntry entry = *runs[run].first++;
+		this->symbols_out.push_back({ this->prefix_add + entry->first + this->suffix_add, entry->second });
+
+		if (runs[run].first != runs[run].second) {
+			merge_queue.push(run);
+		}
+	}
+
+	// Runs are only ordered by value, so names sharing a value still need ordering
+	for (auto group_start = this->symbols_out.begin(); group_start != this->symbols_out.end();) {
+		auto group_end = group_start + 1;
+		while (group_end != this->symbols_out.end() && group_end->value == group_start->value) {
+			group_end++;
+		}
+		if (group_end - group_start > 1) {
+			std::sort(group_start, group_end, CompareSymbols);
+		}
+		group_start = group_end;
+	}
+}
+
+void Symbols::Output(const std::string& file_name, const ValueType value_type, const NumberBase number_base, const OutputMode output_mode,
+                     const AsmDialect asm_dialect)
+{
+#ifdef _WIN32
+	if (file_name.compare("-") == 0) {
+		if (output_mode == OutputMode::Binary) {
+			SetBinaryMode(stdout);
+		}
+		this->Output(std::cout, value_type, number_base, output_mode, asm_dialect);
+		std::cout.flush();
+		return;
+	}
+
+	std::ofstream output(file_name, output_mode == OutputMode::Binary ? (std::ios::out | std::ios::binary) : std::ios::out);
+	if (!output.is_open()) {
+		throw std::runtime_error(("Cannot open \"" + file_name + "\" for writing.").c_str());
+	}
+
+	this->Output(output, value_type, number_base, output_mode, asm_dialect);
+#else
+	if (file_name.compare("-") == 0) {
+		std::cout.flush();
+	}
+
+	OutputFile output_file;
+	if (!output_file.Open(file_name)) {
+		throw std::runtime_error(("Cannot open \"" + file_name + "\" for writing.").c_str());
+	}
+
+	std::ostream output(&output_file);
+	this->Output(output, value_type, number_base, output_mode, asm_dialect);
+	output_file.Close();
+#endif
+}
+
+void Symbols::WriteOutputs(const std::string& file_name, const ValueType value_type, const NumberBase number_base, const OutputMode output_mode,
+                           const AsmDialect asm_dialect)
+{
+	if (!file_name.empty()) {
+		this->Output(file_name, value_type, number_base, output_mode, asm_dialect);
+	}
+	this->OutputShards(value_type, number_base, output_mode, asm_dialect);
+}
+
+void Symbols::Output(std::ostream& output, const ValueType value_type, const NumberBase number_base, const OutputMode output_mode,
+                     const AsmDialect asm_dialect)
+{
+	switch (output_mode) {
+		case OutputMode::Binary:
+			this->OutputBinary(output, value_type, number_base);
+			break;
+		case OutputMode::Asm:
+			this->OutputAsm(output, value_type, number_base, asm_dialect);
+			break;
+		case OutputMode::C:
+			this->OutputC(output, value_type, number_base);
+			break;
+		case OutputMode::AsmHash:
+			this->OutputAsmHash(output, value_type, number_base, asm_dialect);
+			break;
+		case OutputMode::CHash:
+			this->OutputCHash(output, value_type, number_base);
+			break;
+	}
+}
+
+void Symbols::AddSymbol(const std::string& name, long long value)
+{
+	bool dont_filter = this->symbol_includes.empty() && this->prefix_includes.empty() && this->suffix_includes.empty();
+
+	for (const auto& prefix_include : prefix_includes) {
+		if (StringStartsWith(name, prefix_include)) {
+			dont_filter = true;
+			break;
+		}
+	}
+	for (const auto& suffix_include : suffix_includes) {
+		if (StringEndsWith(name, suffix_include)) {
+			dont_filter = true;
+			break;
+		}
+	}
+	for (const auto& prefix_exclude : prefix_excludes) {
+		if (StringStartsWith(name, prefix_exclude)) {
+			dont_filter = false;
+			break;
+		}
+	}
+	for (const auto& suffix_exclude : suffix_excludes) {
+		if (StringEndsWith(name, suffix_exclude)) {
+			dont_filter = false;
+			break;
+		}
+	}
+	if (!this->symbol_includes.empty() && this->symbol_includes.count(name) != 0) {
+		dont_filter = true;
+	}
+	if (!this->symbol_excludes.empty() && this->symbol_excludes.count(name) != 0) {
+		dont_filter = false;
+	}
+
+	if (dont_filter) {
+		if (this->streaming) {
+			this->StreamSymbol(name, value);
+		} else if (this->max_memory != 0) {
+			this->BufferSymbol(name, value);
+		} else {
+			auto entry = this->symbols.emplace(name, value);
+			if (!entry.second) {
+				if (entry.first->second != value) {
+					throw std::runtime_error(("Multiple definitions of symbol \"" + name + "\" detected.").c_str());
+				}
+			} else if (!this->symbol_runs.empty()) {
+				SymbolRun& run = this->symbol_runs.back();
+				if (run.sorted && !run.entries.empty() && run.entries.back()->second > value) {
+					run.sorted = false;
+				}
+				run.entries.push_back(&*entry.first);
+			}
+		}
+
+		if (this->track_inputs) {
+			this->input_symbols[this->current_input].push_back(name);
+			this->symbol_references[name]++;
+		}
+	}
+}
+
+int Symbols::GetLineLength()
+{
+	int line_length = this->output_length;
+	if ((line_length & 7) != 0) {
+		line_length &= ~7;
+	}
+	line_length += 8;
+
+	return line_length;
+}
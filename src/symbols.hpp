@@ -1,62 +1,178 @@
-/*
-	Copyright (c) 2025 Devon Artmeier
-
-	Permission to use, copy, modify, and /or distribute this software
-	for any purpose with or without fee is hereby granted.
-
-	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
-	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
-	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
-	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
-	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
-	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
-	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
-	PERFORMANCE OF THIS SOFTWARE.
-*/
-
-#ifndef SYMBOLS_HPP
-#define SYMBOLS_HPP
-
-class Symbols
-{
-public:
-	void LoadSymbols     (const std::string& file_name);
-	void SetValueOffset  (const std::string& offset);
-	void AddSymbolInclude(const std::string& symbol);
-	void AddPrefixInclude(const std::string& prefix);
-	void AddSuffixInclude(const std::string& suffix);
-	void AddSymbolExclude(const std::string& symbol);
-	void AddPrefixExclude(const std::string& prefix);
-	void AddSuffixExclude(const std::string& suffix);
-	void SetPrefixAdd    (const std::string& prefix);
-	void SetSuffixAdd    (const std::string& suffix);
-	void GetOutputSymbols();
-	void Output          (const std::string& file_name, const ValueType value_type, const NumberBase number_base, const OutputMode output_mode);
-
-private:
-	void AddSymbol          (const std::string& name, long long value);
-	int  GetLineLength      ();
-	bool LoadBinarySymbols  (const std::string& file_name);
-	bool LoadPsyqSymbols    (const std::string& file_name);
-	bool LoadVasmLstSymbols (const std::string& file_name);
-	bool LoadVasmVobjSymbols(const std::string& file_name);
-	bool LoadVlinkSymSymbols(const std::string& file_name);
-	void OutputBinary       (const std::string& file_name, const ValueType value_type, const NumberBase number_base);
-	void OutputAsm          (const std::string& file_name, const ValueType value_type, const NumberBase number_base);
-	void OutputC            (const std::string& file_name, const ValueType value_type, const NumberBase number_base);
-	
-	std::vector<std::string>                   input_file_names;
-	std::unordered_map<std::string, long long> symbols;
-	std::vector<Symbol>                        symbols_out;
-	std::string                                value_offset   { "" };
-	std::vector<std::string>                   symbol_includes;
-	std::vector<std::string>                   prefix_includes;
-	std::vector<std::string>                   suffix_includes;
-	std::vector<std::string>                   symbol_excludes;
-	std::vector<std::string>                   prefix_excludes;
-	std::vector<std::string>                   suffix_excludes;
-	std::string                                prefix_add     { "" };
-	std::string                                suffix_add     { "" };
-};
-
-#endif // SYMBOLS_HPP
+/*
+	Copyright (c) 2025 Devon Artmeier
+
+	Permission to use, copy, modify, and /or distribute this software
+	for any purpose with or without fee is hereby granted.
+
+	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
+	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
+	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+	PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef SYMBOLS_HPP
+#define SYMBOLS_HPP
+
+class Symbols
+{
+public:
+	~Symbols();
+
+	void LoadSymbols         (const std::string& file_name);
+	void LoadSymbols         (const std::vector<std::string>& file_names);
+	bool LoadSymbols         (const std::string& input_name, const unsigned char* data, const size_t size);
+	void SetValueOffset      (const std::string& offset);
+	void SetMaxMemory        (const std::string& size);
+	void SetOutputFile       (const std::string& file_name);
+	void AddArchiveMember    (const std::string& member);
+	void AddSymbolInclude    (const std::string& symbol);
+	void AddPrefixInclude    (const std::string& prefix);
+	void AddSuffixInclude    (const std::string& suffix);
+	void AddSymbolExclude    (const std::string& symbol);
+	void AddSymbolIncludeList(const std::string& file_name);
+	void AddSymbolExcludeList(const std::string& file_name);
+	void AddPrefixExclude    (const std::string& prefix);
+	void AddSuffixExclude    (const std::string& suffix);
+	void SetPrefixAdd        (const std::string& prefix);
+	void SetSuffixAdd        (const std::string& suffix);
+	void AddRemapRange       (const std::string& range);
+	void AddRemapFile        (const std::string& file_name);
+	void SetUnmappedMode     (const std::string& mode);
+	void AddShard            (const std::string& shard);
+	void AddShardFile        (const std::string& file_name);
+	bool HasShards           ();
+	void GetOutputSymbols    ();
+	void Output              (const std::string& file_name, const ValueType value_type, const NumberBase number_base, const OutputMode output_mode,
+	                          const AsmDialect asm_dialect);
+	void Output              (std::ostream& output, const ValueType value_type, const NumberBase number_base, const OutputMode output_mode,
+	                          const AsmDialect asm_dialect);
+	void AppendBinary        (const std::string& file_name);
+	void AppendHistory       (const std::string& file_name, const std::string& build_label);
+	void WriteOutputs        (const std::string& file_name, const ValueType value_type, const NumberBase number_base, const OutputMode output_mode,
+	                          const AsmDialect asm_dialect);
+	void Watch               (const std::string& file_name, const ValueType value_type, const NumberBase number_base, const OutputMode output_mode,
+	                          const AsmDialect asm_dialect);
+	void SetWatch            ();
+	void SetStream           ();
+
+	template<typename Callback>
+	void ForEachOutputSymbol(Callback&& callback);
+
+private:
+	bool   LoadInputSymbols   (const std::string& input_name, const unsigned char* data, const size_t size);
+	void   DiscardInputRun    ();
+	void   ReloadSymbols      (const std::string& file_name);
+	void   RetractSymbols     (const std::string& file_name);
+	void   AddSymbol          (const std::string& name, long long value);
+	void   MergeSymbolRuns    ();
+	bool   CanStream          (const std::vector<std::string>& file_names);
+	void   OpenStream         (const std::string& file_name);
+	bool   StreamInput        (const std::function<void(const Symbol&)>& callback);
+	void   StreamSymbol       (const std::string& name, long long value);
+	void   FlushStreamGroup   ();
+	void   CheckStreamNames   (std::vector<size_t>& name_hashes);
+	void   StreamOutputSymbols(const std::function<void(const Symbol&)>& callback);
+	int    GetLineLength      ();
+	bool   LoadBinarySymbols  (const std::string& file_name, InputBuffer& input);
+	bool   LoadArchiveSymbols (const std::string& file_name, InputBuffer& input);
+	bool   LoadPsyqSymbols    (const std::string& file_name, InputBuffer& input);
+	bool   LoadVasmLstSymbols (const std::string& file_name, InputBuffer& input);
+	bool   LoadVasmVobjSymbols(const std::string& file_name, InputBuffer& input);
+	bool   LoadLinkerMapSymbols(const std::string& file_name, InputBuffer& input);
+	bool   LoadVlinkSymSymbols(const std::string& file_name, InputBuffer& input);
+	bool   IsArchiveMemberIncluded(const std::string& member);
+	void   OutputBinary       (std::ostream& output, const ValueType value_type, const NumberBase number_base);
+	void   OutputAsm          (std::ostream& output, const ValueType value_type, const NumberBase number_base, const AsmDialect asm_dialect);
+	void   OutputC            (std::ostream& output, const ValueType value_type, const NumberBase number_base);
+	void   OutputAsmHash      (std::ostream& output, const ValueType value_type, const NumberBase number_base, const AsmDialect asm_dialect);
+	void   OutputCHash        (std::ostream& output, const ValueType value_type, const NumberBase number_base);
+	void   BufferSymbol       (const std::string& name, long long value);
+	void   SpillSymbols       ();
+	void   MergeSpilledSymbols();
+	size_t GetOutputCount     ();
+	void   MergeOutputRuns    (const std::function<void(const Symbol&)>& callback);
+	void   CompileRemapRanges ();
+	bool   RemapUnmappedSymbol(const Symbol& symbol);
+	bool   RemapSymbol        (Symbol& symbol);
+	void   RemapOutputSymbols ();
+	void   ReportUnmappedSymbols();
+	void   AssignShards       (std::vector<std::vector<Symbol>>& shard_symbols);
+	void   OutputShards       (const ValueType value_type, const NumberBase number_base, const OutputMode output_mode, const AsmDialect asm_dialect);
+
+	static bool DecodeVasmVobjSymbols(InputBuffer& input, std::vector<Symbol>& symbols_found);
+
+	template<typename Dialect>
+	void OutputText(std::ostream& output, const ValueType value_type, const NumberBase number_base);
+
+	template<typename Dialect, ValueType value_type>
+	void OutputTextSymbols(std::ostream& output, std::vector<std::string>& buffers, const NumberBase number_base);
+
+	template<typename Dialect, ValueType value_type, NumberBase number_base>
+	void OutputTextLines(std::ostream& output, std::vector<std::string>& buffers);
+	
+	std::vector<std::string>                                  input_file_names;
+	std::unordered_map<std::string, long long>                symbols;
+	std::vector<Symbol>                                       symbols_out;
+	std::vector<SymbolRun>                                    symbol_runs;
+	std::string                                               value_offset  { "" };
+	std::unordered_set<std::string>                           symbol_includes;
+	std::vector<std::string>                                  prefix_includes;
+	std::vector<std::string>                                  suffix_includes;
+	std::unordered_set<std::string>                           symbol_excludes;
+	std::vector<std::string>                                  prefix_excludes;
+	std::vector<std::string>                                  suffix_excludes;
+	std::string                                               prefix_add    { "" };
+	std::string                                               suffix_add    { "" };
+	size_t                                                    max_memory    { 0 };
+	size_t                                                    buffer_memory { 0 };
+	std::vector<Symbol>                                       symbol_buffer;
+	SpillFile                                                 name_runs;
+	SpillFile                                                 value_runs;
+	size_t                                                    output_count  { 0 };
+	int                                                       output_length { 0 };
+	bool                                                      track_inputs  { false };
+	std::string                                               current_input { "" };
+	std::unordered_map<std::string, std::vector<std::string>> input_symbols;
+	std::unordered_map<std::string, int>                      symbol_references;
+	std::vector<RemapRange>                                   remap_ranges;
+	bool                                                      remap_compiled { false };
+	UnmappedMode                                              unmapped_mode  { UnmappedMode::Keep };
+	size_t                                                    unmapped_count { 0 };
+	std::vector<Shard>                                        shards;
+	std::string                                               output_file    { "" };
+	std::vector<std::string>                                  archive_members;
+	bool                                                      stream         { false };
+	bool                                                      streaming      { false };
+	std::string                                               stream_name    { "" };
+#ifndef _WIN32
+	MappedFile                                                stream_file;
+#endif
+	std::vector<unsigned char>                                stream_buffer;
+	const unsigned char*                                      stream_data    { nullptr };
+	size_t                                                    stream_size    { 0 };
+	std::function<void(const Symbol&)>                        stream_callback;
+	bool                                                      stream_ordered { true };
+	std::vector<Symbol>                                       stream_group;
+	Symbol                                                    stream_previous;
+	bool                                                      stream_have_previous { false };
+};
+
+template<typename Callback>
+void Symbols::ForEachOutputSymbol(Callback&& callback)
+{
+	if (this->streaming) {
+		this->StreamOutputSymbols(callback);
+	} else if (this->value_runs.runs.empty()) {
+		for (const auto& symbol : this->symbols_out) {
+			callback(symbol);
+		}
+	} else {
+		this->MergeOutputRuns(callback);
+	}
+}
+
+#endif // SYMBOLS_HPP
@@ -0,0 +1,134 @@
+/*
+	Copyright (c) 2025 Devon Artmeier
+
+	Permission to use, copy, modify, and /or distribute this software
+	for any purpose with or without fee is hereby granted.
+
+	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
+	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
+	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+	PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef TEXT_LINES_HPP
+#define TEXT_LINES_HPP
+
+static const size_t TEXT_CHUNK_SIZE       = 0x100000;
+static const size_t TEXT_CHUNKS_PER_ROUND = 4;
+
+struct TextChunk
+{
+	size_t              start;
+	size_t              end;
+	size_t              line_count;
+	size_t              error_line;
+	std::vector<Symbol> symbols;
+	std::exception_ptr  error;
+};
+
+// Parses the rest of the input as one symbol per line. Unless parallel is false, the input is split
+// into chunks at line boundaries that are parsed in parallel, and their symbols are handed to
+// add_symbol in input order. parse_line returns false for a malformed line; the result is then that
+// line's number (the line at the current offset being first_line), or 0 if every line was parsed.
+template<typename ParseLine, typename AddSymbol>
+static size_t ParseSymbolLines(InputBuffer& input, const size_t first_line, const bool parallel, ParseLine parse_line, AddSymbol add_symbol)
+{
+	// Small inputs and single cores parse straight into add_symbol, since buffering chunks only adds copies
+	if (!parallel || std::thread::hardware_concurrency() < 2 || input.size - input.offset < TEXT_CHUNK_SIZE * 2) {
+		std::string line;
+		Symbol      symbol;
+
+		for (size_t line_number = first_line; ReadInputLine(input, line); line_number++) {
+			if (line.empty()) {
+				continue;
+			}
+			if (!parse_line(line, symbol)) {
+				return line_number;
+			}
+			add_symbol(symbol);
+		}
+		return 0;
+	}
+
+	std::vector<TextChunk> chunks;
+	for (size_t start = input.offset; start < input.size;) {
+		size_t end = std::min(start + TEXT_CHUNK_SIZE, input.size);
+		if (end < input.size) {
+			const void* line_end = memchr(input.data + end, '\n', input.size - end);
+			end = line_end != nullptr ? (static_cast<const unsigned char*>(line_end) - input.data) + 1 : input.size;
+		}
+		chunks.push_back({ start, end, 0, 0, {}, nullptr });
+		start = end;
+	}
+	input.offset = input.size;
+
+	auto parse_chunk = [&](TextChunk& chunk) {
+		try {
+			InputBuffer chunk_input = { input.data, chunk.end, chunk.start };
+			std::string line;
+			Symbol      symbol;
+
+			while (ReadInputLine(chunk_input, line)) {
+				chunk.line_count++;
+				if (line.empty()) {
+					continue;
+				}
+				if (!parse_line(line, symbol)) {
+					chunk.error_line = chunk.line_count;
+					return;
+				}
+				chunk.symbols.push_back(std::move(symbol));
+			}
+		} catch (...) {
+			chunk.error = std::current_exception();
+		}
+	};
+
+	// Chunks are parsed a few rounds ahead of the merge, so only part of the file is held as parsed symbols
+	size_t thread_count = std::min<size_t>(std::max(1U, std::thread::hardware_concurrency()), chunks.size());
+	size_t round_size   = std::max<size_t>(1, thread_count * TEXT_CHUNKS_PER_ROUND);
+	size_t line         = first_line;
+
+	for (size_t round_start = 0; round_start < chunks.size(); round_start += round_size) {
+		size_t              round_end = std::min(round_start + round_size, chunks.size());
+		std::atomic<size_t> next_chunk(round_start);
+
+		auto parse_chunks = [&]() {
+			size_t chunk;
+			while ((chunk = next_chunk++) < round_end) {
+				parse_chunk(chunks[chunk]);
+			}
+		};
+
+		std::vector<std::thread> threads;
+		for (size_t i = 1; i < std::min(thread_count, round_end - round_start); i++) {
+			threads.emplace_back(parse_chunks);
+		}
+		parse_chunks();
+		for (auto& thread : threads) {
+			thread.join();
+		}
+
+		for (size_t i = round_start; i < round_end; i++) {
+			if (chunks[i].error) {
+				std::rethrow_exception(chunks[i].error);
+			}
+			for (const auto& symbol : chunks[i].symbols) {
+				add_symbol(symbol);
+			}
+			if (chunks[i].error_line != 0) {
+				return line + chunks[i].error_line - 1;
+			}
+			line += chunks[i].line_count;
+			std::vector<Symbol>().swap(chunks[i].symbols);
+		}
+	}
+
+	return 0;
+}
+
+#endif // TEXT_LINES_HPP
@@ -1,50 +1,110 @@
-
-
-/*
-	Copyright (c) 2025 Devon Artmeier
-
-	Permission to use, copy, modify, and /or distribute this software
-	for any purpose with or without fee is hereby granted.
-
-	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
-	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
-	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
-	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
-	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
-	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
-	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
-	PERFORMANCE OF THIS SOFTWARE.
-*/
-
-#ifndef TYPES_HPP
-#define TYPES_HPP
-
-struct Symbol
-{
-	std::string name;
-	long long   value;
-};
-
-enum class ValueType
-{
-	Unsigned32,
-	Unsigned64,
-	Signed32,
-	Signed64,
-};
-
-enum class NumberBase
-{
-	Hex,
-	Decimal,
-	Binary
-};
-
-enum OutputMode
-{
-	Binary,
-	Asm,
-	C
-};
-
-#endif // TYPES_HPP
+
+
+/*
+	Copyright (c) 2025 Devon Artmeier
+
+	Permission to use, copy, modify, and /or distribute this software
+	for any purpose with or without fee is hereby granted.
+
+	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
+	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
+	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+	PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef TYPES_HPP
+#define TYPES_HPP
+
+struct Symbol
+{
+	std::string name;
+	long long   value;
+};
+
+struct SymbolRun
+{
+	std::vector<const std::pair<const std::string, long long>*> entries;
+	bool                                                        sorted;
+};
+
+struct SpillRun
+{
+	unsigned long long offset;
+	unsigned long long size;
+};
+
+struct SpillFile
+{
+	FILE*                 file { nullptr };
+	unsigned long long    size { 0 };
+	std::vector<SpillRun> runs;
+};
+
+struct RemapRange
+{
+	long long start;
+	long long end;
+	long long target;
+};
+
+struct Shard
+{
+	std::string file_name;
+	std::string prefix;
+	long long   start;
+	long long   end;
+	bool        is_prefix;
+};
+
+struct InputBuffer
+{
+	const unsigned char* data;
+	size_t               size;
+	size_t               offset;
+};
+
+enum class ValueType
+{
+	Unsigned32,
+	Unsigned64,
+	Signed32,
+	Signed64,
+};
+
+enum class NumberBase
+{
+	Hex,
+	Decimal,
+	Binary
+};
+
+enum class AsmDialect
+{
+	Asm68k,
+	Vasm,
+	Ca65,
+	Nasm,
+	Gas
+};
+
+enum class UnmappedMode
+{
+	Keep,
+	Drop,
+	Error
+};
+
+enum OutputMode
+{
+	Binary,
+	Asm,
+	C,
+	AsmHash,
+	CHash
+};
+
+#endif // TYPES_HPP
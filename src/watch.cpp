@@ -0,0 +1,193 @@
+/*
+	Copyright (c) 2025 Devon Artmeier
+
+	Permission to use, copy, modify, and /or distribute this software
+	for any purpose with or without fee is hereby granted.
+
+	THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+	WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIE
+	WARRANTIES OF MERCHANTABILITY AND FITNESS.IN NO EVENT SHALL THE
+	AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+	DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+	PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+	TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+	PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "shared.hpp"
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+static bool CompareOutputSymbols(const std::vector<Symbol>& symbols_1, const std::vector<Symbol>& symbols_2)
+{
+	if (symbols_1.size() != symbols_2.size()) {
+		return false;
+	}
+	for (size_t i = 0; i < symbols_1.size(); i++) {
+		if (symbols_1[i].value != symbols_2[i].value || symbols_1[i].name != symbols_2[i].name) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void Symbols::SetWatch()
+{
+	if (this->max_memory != 0) {
+		throw std::runtime_error("Watch mode cannot be used with a memory limit.");
+	}
+	this->track_inputs = true;
+}
+
+void Symbols::RetractSymbols(const std::string& file_name)
+{
+	auto input = this->input_symbols.find(file_name);
+	if (input == this->input_symbols.end()) {
+		return;
+	}
+
+	for (const auto& name : input->second) {
+		auto reference = this->symbol_references.find(name);
+		if (--reference->second == 0) {
+			this->symbol_references.erase(reference);
+			this->symbols.erase(name);
+		}
+	}
+	this->input_symbols.erase(input);
+}
+
+void Symbols::ReloadSymbols(const std::string& file_name)
+{
+	std::vector<unsigned char> buffer;
+	ReadFile(file_name, buffer);
+
+	this->RetractSymbols(file_name);
+	try {
+		if (!this->LoadInputSymbols(file_name, buffer.data(), buffer.size())) {
+			throw std::runtime_error(("\"" + file_name + "\" is not a valid file.").c_str());
+		}
+	} catch (...) {
+		this->RetractSymbols(file_name);
+		throw;
+	}
+}
+
+#ifdef __linux__
+
+void Symbols::Watch(const std::string& file_name, const ValueType value_type, const NumberBase number_base, const OutputMode output_mode,
+                    const AsmDialect asm_dialect)
+{
+	if (!this->track_inputs) {
+		throw std::runtime_error("Watch mode was not enabled before loading symbols.");
+	}
+
+	int notify = inotify_init1(IN_CLOEXEC);
+	if (notify < 0) {
+		throw std::runtime_error("Cannot initialize file watching.");
+	}
+
+	std::unordered_map<std::string, std::vector<std::string>> watched_files;
+
+	for (const auto& input_file_name : this->input_file_names) {
+		size_t      slash     = input_file_name.find_last_of('/');
+		std::string directory = slash == std::string::npos ? "." : input_file_name.substr(0, slash + 1);
+		std::string base_name = slash == std::string::npos ? input_file_name : input_file_name.substr(slash + 1);
+
+		int watch = inotify_add_watch(notify, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+		if (watch < 0) {
+			close(notify);
+			throw std::runtime_error(("Cannot watch \"" + input_file_name + "\" for changes.").c_str());
+		}
+
+		watched_files[std::to_string(watch) + "/" + base_name].push_back(input_file_name);
+	}
+
+	std::vector<Symbol>         previous_symbols = this->symbols_out;
+	std::vector<std::string>    failed_files;
+	alignas(inotify_event) char event_buffer[0x1000];
+
+	std::cout << "Watching " << this->input_file_names.size() << " input file(s) for changes." << std::endl;
+
+	while (true) {
+		std::vector<std::string> changed_files;
+		int                      timeout = -1;
+
+		while (true) {
+			pollfd poll_notify = { notify, POLLIN, 0 };
+			if (poll(&poll_notify, 1, timeout) <= 0) {
+				break;
+			}
+
+			ssize_t read_count = read(notify, event_buffer, sizeof(event_buffer));
+			if (read_count <= 0) {
+				break;
+			}
+
+			for (char* event_data = event_buffer; event_data < event_buffer + read_count;) {
+				inotify_event* event = reinterpret_cast<inotify_event*>(event_data);
+				event_data += sizeof(inotify_event) + event->len;
+
+				if (event->len == 0) {
+					continue;
+				}
+
+				auto watched = watched_files.find(std::to_string(event->wd) + "/" + event->name);
+				if (watched == watched_files.end()) {
+					continue;
+				}
+				for (const auto& changed_file : watched->second) {
+					if (std::find(changed_files.begin(), changed_files.end(), changed_file) == changed_files.end()) {
+						changed_files.push_back(changed_file);
+					}
+				}
+			}
+
+			timeout = 2;
+		}
+
+		for (const auto& failed_file : failed_files) {
+			if (std::find(changed_files.begin(), changed_files.end(), failed_file) == changed_files.end()) {
+				changed_files.push_back(failed_file);
+			}
+		}
+
+		failed_files.clear();
+		for (const auto& changed_file : changed_files) {
+			try {
+				this->ReloadSymbols(changed_file);
+			} catch (std::exception& e) {
+				std::cerr << "Error: " << e.what() << std::endl;
+				failed_files.push_back(changed_file);
+			}
+		}
+
+		if (!failed_files.empty()) {
+			continue;
+		}
+
+		this->GetOutputSymbols();
+		if (!CompareOutputSymbols(previous_symbols, this->symbols_out)) {
+			try {
+				this->WriteOutputs(file_name, value_type, number_base, output_mode, asm_dialect);
+				previous_symbols = this->symbols_out;
+				std::cout << "Updated outputs (" << this->symbols_out.size() << " symbols)." << std::endl;
+			} catch (std::exception& e) {
+				std::cerr << "Error: " << e.what() << std::endl;
+			}
+		}
+	}
+}
+
+#else
+
+void Symbols::Watch(const std::string& file_name, const ValueType value_type, const NumberBase number_base, const OutputMode output_mode,
+                    const AsmDialect asm_dialect)
+{
+	throw std::runtime_error("Watch mode is not supported on this platform.");
+}
+
+#endif